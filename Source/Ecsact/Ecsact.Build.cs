@@ -32,6 +32,7 @@ public class Ecsact : ModuleRules {
 		PrivateDependencyModuleNames.AddRange(new string[] {
 			"CoreUObject",
 			"Engine",
+			"Json",
 			"Slate",
 			"SlateCore",
 		});
@@ -0,0 +1,388 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#include "EcsactBenchmarkCommandlet.h"
+#include "Dom/JsonObject.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "EcsactUnreal/Ecsact.h"
+#include "EcsactUnreal/EcsactSettings.h"
+#include "EcsactUnreal/EcsactSyncRunner.h"
+#include "EcsactUnreal/EcsactReplayRunner.h"
+#include "EcsactUnreal/RuntimeLoad.h"
+#include "ecsact/runtime/core.h"
+#include "ecsact/runtime/serialize.h"
+
+namespace {
+/**
+ * Bytes tracked by LLM across the whole process or -1 when the commandlet
+ * wasn't started with `-llm`.
+ */
+auto GetLLMTrackedBytes() -> int64 {
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if(FLowLevelMemTracker::IsEnabled()) {
+		auto& tracker = FLowLevelMemTracker::Get();
+		tracker.UpdateStatsPerFrame();
+		return tracker.GetTagAmountForTracker(
+			ELLMTracker::Default,
+			ELLMTag::TrackedTotal
+		);
+	}
+#endif
+	return -1;
+}
+
+struct FEcsactBenchmarkResult {
+	FString Name;
+	int32   Ticks = 0;
+	int64   Events = 0;
+	double  Seconds = 0.0;
+	int64   UsedPhysicalDelta = 0;
+	int64   PeakUsedPhysicalDelta = 0;
+	int64   LLMTrackedBytesDelta = -1;
+
+	auto ToJson() const -> TSharedRef<FJsonObject> {
+		auto json = MakeShared<FJsonObject>();
+		auto ticks = FMath::Max(Ticks, 1);
+		json->SetStringField(TEXT("name"), Name);
+		json->SetNumberField(TEXT("ticks"), Ticks);
+		json->SetNumberField(TEXT("events"), static_cast<double>(Events));
+		json->SetNumberField(TEXT("seconds"), Seconds);
+		json->SetNumberField(
+			TEXT("ns_per_event"),
+			Events > 0 ? (Seconds * 1e9) / Events : 0.0
+		);
+		json->SetNumberField(
+			TEXT("events_per_sec"),
+			Seconds > 0.0 ? Events / Seconds : 0.0
+		);
+		json->SetNumberField(
+			TEXT("used_physical_delta"),
+			static_cast<double>(UsedPhysicalDelta)
+		);
+		json->SetNumberField(
+			TEXT("peak_used_physical_delta"),
+			static_cast<double>(PeakUsedPhysicalDelta)
+		);
+		if(LLMTrackedBytesDelta != -1) {
+			json->SetNumberField(
+				TEXT("llm_tracked_bytes_per_tick"),
+				static_cast<double>(LLMTrackedBytesDelta) / ticks
+			);
+		}
+		return json;
+	}
+};
+} // namespace
+
+bool UEcsactBenchmarkRunnerSubsystem::bEnabled = false;
+
+auto UEcsactBenchmarkRunnerSubsystem::ShouldCreateSubsystem( //
+	UObject* Outer
+) const -> bool {
+	return bEnabled;
+}
+
+auto UEcsactBenchmarkRunnerSubsystem::InitComponentRaw(
+	ecsact_entity_id    EntityId,
+	ecsact_component_id ComponentId,
+	const void*         ComponentData
+) -> void {
+	EventCount += 1;
+}
+
+auto UEcsactBenchmarkRunnerSubsystem::UpdateComponentRaw(
+	ecsact_entity_id    EntityId,
+	ecsact_component_id ComponentId,
+	const void*         ComponentData
+) -> void {
+	EventCount += 1;
+}
+
+auto UEcsactBenchmarkRunnerSubsystem::RemoveComponentRaw(
+	ecsact_entity_id    EntityId,
+	ecsact_component_id ComponentId,
+	const void*         ComponentData
+) -> void {
+	EventCount += 1;
+}
+
+auto UEcsactBenchmarkRunnerSubsystem::EntityCreated_Implementation( //
+	int32 Entity
+) -> void {
+	EventCount += 1;
+}
+
+auto UEcsactBenchmarkRunnerSubsystem::EntityDestroyed_Implementation( //
+	int32 Entity
+) -> void {
+	EventCount += 1;
+}
+
+UEcsactBenchmarkCommandlet::UEcsactBenchmarkCommandlet() {
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+auto UEcsactBenchmarkCommandlet::Main(const FString& Params) -> int32 {
+	auto entity_count = int32{10000};
+	auto tick_count = int32{100};
+	auto action_id = int32{-1};
+	auto actions_per_tick = int32{1000};
+	auto component_id = int32{-1};
+	auto updates_per_tick = int32{1000};
+	auto runtime_path = FString{};
+	auto replay_path = FString{};
+	auto output_path = FString{};
+
+	FParse::Value(*Params, TEXT("Entities="), entity_count);
+	FParse::Value(*Params, TEXT("Ticks="), tick_count);
+	FParse::Value(*Params, TEXT("Action="), action_id);
+	FParse::Value(*Params, TEXT("ActionsPerTick="), actions_per_tick);
+	FParse::Value(*Params, TEXT("Component="), component_id);
+	FParse::Value(*Params, TEXT("UpdatesPerTick="), updates_per_tick);
+	FParse::Value(*Params, TEXT("Runtime="), runtime_path);
+	FParse::Value(*Params, TEXT("Replay="), replay_path);
+	FParse::Value(*Params, TEXT("Output="), output_path);
+
+	auto runtime_handle = FEcsactRuntimeHandle{};
+	if(ecsact_execute_systems == nullptr) {
+		if(!runtime_path.IsEmpty()) {
+			auto settings = GetMutableDefault<UEcsactSettings>();
+#if WITH_EDITORONLY_DATA
+			settings->bEnableBuild = false;
+#endif
+			settings->CustomEcsactRuntimeLibraryPath = runtime_path;
+		}
+		runtime_handle = ECSACT_LOAD_RUNTIME();
+	}
+
+	if(ecsact_execute_systems == nullptr || ecsact_create_registry == nullptr) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("EcsactBenchmark requires a runtime with ecsact_execute_systems "
+					 "and ecsact_create_registry")
+		);
+		if(runtime_handle) {
+			ECSACT_UNLOAD_RUNTIME(runtime_handle);
+		}
+		return 1;
+	}
+
+	auto component_data = TArray<uint8>{};
+	if(component_id != -1) {
+		auto component_size = ecsact_serialize_component_size
+			? ecsact_serialize_component_size(
+					static_cast<ecsact_component_id>(component_id)
+				)
+			: 0;
+		if(component_size > 0) {
+			component_data.SetNumZeroed(component_size);
+		} else {
+			UE_LOG(
+				Ecsact,
+				Warning,
+				TEXT("Creating entities without components - unable to get size "
+						 "of component %i"),
+				component_id
+			);
+		}
+	}
+
+	UEcsactBenchmarkRunnerSubsystem::bEnabled = true;
+	auto runner = NewObject<UEcsactSyncRunner>();
+	runner->AddToRoot();
+	runner->registry_id = ecsact_create_registry("EcsactBenchmark");
+	runner->Start();
+
+	auto counter = runner->GetSubsystem<UEcsactBenchmarkRunnerSubsystem>();
+	check(counter);
+
+	// The process peak can't be reset so scenarios sample memory after every
+	// tick. Time spent sampling isn't part of the scenario's time.
+	auto peak_used = int64{0};
+	auto sample_seconds = 0.0;
+	auto sample_memory = [&] {
+		auto sample_start = FPlatformTime::Seconds();
+		auto used = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+		peak_used = FMath::Max(peak_used, used);
+		sample_seconds += FPlatformTime::Seconds() - sample_start;
+	};
+
+	auto measure = [&](const TCHAR* Name, int32 Ticks, auto&& Body) {
+		auto result = FEcsactBenchmarkResult{};
+		result.Name = Name;
+		result.Ticks = Ticks;
+		counter->EventCount = 0;
+		auto llm_before = GetLLMTrackedBytes();
+		auto used_before =
+			static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+		peak_used = used_before;
+		sample_seconds = 0.0;
+		auto start = FPlatformTime::Seconds();
+		Body();
+		result.Seconds = FPlatformTime::Seconds() - start - sample_seconds;
+		sample_memory();
+		result.Events = counter->EventCount;
+		result.UsedPhysicalDelta =
+			static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) -
+			used_before;
+		result.PeakUsedPhysicalDelta = peak_used - used_before;
+		if(llm_before != -1) {
+			result.LLMTrackedBytesDelta = GetLLMTrackedBytes() - llm_before;
+		}
+		UE_LOG(
+			Ecsact,
+			Display,
+			TEXT("%s: %lld events in %.3fms"),
+			Name,
+			result.Events,
+			result.Seconds * 1000.0
+		);
+		return result;
+	};
+
+	auto results = TArray<FEcsactBenchmarkResult>{};
+
+	auto entities = TArray<ecsact_entity_id>{};
+	entities.Reserve(entity_count);
+
+	results.Add(measure(TEXT("bulk_create"), 1, [&] {
+		for(auto i = 0; entity_count > i; ++i) {
+			if(component_data.IsEmpty()) {
+				runner->CreateEntity().Finish();
+				continue;
+			}
+			runner->CreateEntity()
+				.AddComponentRaw(
+					static_cast<ecsact_component_id>(component_id),
+					component_data.GetData(),
+					component_data.Num()
+				)
+				.OnCreate(TDelegate<void(ecsact_entity_id)>::CreateLambda(
+					[&entities](ecsact_entity_id Entity) { entities.Add(Entity); }
+				))
+				.Finish();
+		}
+		runner->Tick(0.f);
+	}));
+
+	// Without -Component only the runtime's own events are measured (e.g.
+	// synthetic updates from a test runtime)
+	auto update_count = entities.IsEmpty() ? 0 : updates_per_tick;
+	results.Add(measure(TEXT("steady_state_update"), tick_count, [&] {
+		auto next_entity = 0;
+		for(auto i = 0; tick_count > i; ++i) {
+			for(auto ui = 0; update_count > ui; ++ui) {
+				runner->UpdateComponentRaw(
+					entities[next_entity],
+					static_cast<ecsact_component_id>(component_id),
+					component_data.GetData(),
+					component_data.Num()
+				);
+				next_entity = (next_entity + 1) % entities.Num();
+			}
+			runner->Tick(0.f);
+			sample_memory();
+		}
+	}));
+
+	if(action_id != -1) {
+		auto action_size = ecsact_serialize_action_size
+			? ecsact_serialize_action_size(static_cast<ecsact_action_id>(action_id))
+			: 0;
+		if(action_size > 0) {
+			auto action_data = TArray<uint8>{};
+			action_data.SetNumZeroed(action_size);
+			results.Add(measure(TEXT("action_push"), tick_count, [&] {
+				for(auto i = 0; tick_count > i; ++i) {
+					for(auto ai = 0; actions_per_tick > ai; ++ai) {
+						runner->PushActionRaw(
+							static_cast<ecsact_action_id>(action_id),
+							action_data.GetData(),
+							action_size
+						);
+					}
+					runner->Tick(0.f);
+					sample_memory();
+				}
+			}));
+		} else {
+			UE_LOG(
+				Ecsact,
+				Warning,
+				TEXT("Skipping action_push - unable to get size of action %i"),
+				action_id
+			);
+		}
+	}
+
+	runner->Stop();
+	if(ecsact_destroy_registry) {
+		ecsact_destroy_registry(runner->registry_id);
+	}
+	runner->RemoveFromRoot();
+
+	if(!replay_path.IsEmpty()) {
+		// Recordings start from an empty registry
+		auto replay_runner = NewObject<UEcsactReplayRunner>();
+		replay_runner->AddToRoot();
+		replay_runner->registry_id =
+			ecsact_create_registry("EcsactBenchmarkReplay");
+		replay_runner->Start();
+		counter = replay_runner->GetSubsystem<UEcsactBenchmarkRunnerSubsystem>();
+		check(counter);
+
+		if(replay_runner->LoadRecording(replay_path)) {
+			auto ticks = replay_runner->GetTickCount();
+			results.Add(measure(TEXT("replay"), ticks, [&] {
+				replay_runner->ReplayAll();
+			}));
+		}
+
+		replay_runner->Stop();
+		if(ecsact_destroy_registry) {
+			ecsact_destroy_registry(replay_runner->registry_id);
+		}
+		replay_runner->RemoveFromRoot();
+	}
+	UEcsactBenchmarkRunnerSubsystem::bEnabled = false;
+
+	if(runtime_handle) {
+		ECSACT_UNLOAD_RUNTIME(runtime_handle);
+	}
+
+	auto scenarios = TArray<TSharedPtr<FJsonValue>>{};
+	for(const auto& result : results) {
+		scenarios.Add(MakeShared<FJsonValueObject>(result.ToJson()));
+	}
+
+	auto report = MakeShared<FJsonObject>();
+	report->SetNumberField(TEXT("entities"), entity_count);
+	report->SetNumberField(TEXT("ticks"), tick_count);
+	report->SetArrayField(TEXT("scenarios"), scenarios);
+
+	auto report_str = FString{};
+	auto writer = TJsonWriterFactory<>::Create(&report_str);
+	FJsonSerializer::Serialize(report, writer);
+
+	if(output_path.IsEmpty()) {
+		UE_LOG(Ecsact, Display, TEXT("%s"), *report_str);
+	} else if(!FFileHelper::SaveStringToFile(report_str, *output_path)) {
+		UE_LOG(Ecsact, Error, TEXT("Failed to write %s"), *output_path);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "EcsactUnreal/EcsactRunnerSubsystem.h"
+#include "EcsactBenchmarkCommandlet.generated.h"
+
+/**
+ * Counts every event the runner dispatches. Only created while
+ * UEcsactBenchmarkCommandlet is running.
+ */
+UCLASS()
+
+class UEcsactBenchmarkRunnerSubsystem : public UEcsactRunnerSubsystem {
+	GENERATED_BODY() // NOLINT
+
+	friend class UEcsactBenchmarkCommandlet;
+	static bool bEnabled;
+
+	int64 EventCount = 0;
+
+protected:
+	void InitComponentRaw(
+		ecsact_entity_id    EntityId,
+		ecsact_component_id ComponentId,
+		const void*         ComponentData
+	) override;
+	void UpdateComponentRaw(
+		ecsact_entity_id    EntityId,
+		ecsact_component_id ComponentId,
+		const void*         ComponentData
+	) override;
+	void RemoveComponentRaw(
+		ecsact_entity_id    EntityId,
+		ecsact_component_id ComponentId,
+		const void*         ComponentData
+	) override;
+
+public:
+	auto ShouldCreateSubsystem(UObject* Outer) const -> bool override;
+	auto EntityCreated_Implementation(int32 Entity) -> void override;
+	auto EntityDestroyed_Implementation(int32 Entity) -> void override;
+};
+
+/**
+ * Measures UEcsactSyncRunner throughput against the configured Ecsact runtime
+ * and reports the results as JSON.
+ *
+ * @example
+ * ```
+ * UnrealEditor-Cmd Project.uproject -run=EcsactBenchmark -Entities=10000
+ *   -Component=2 -Ticks=100 -Action=3 -ActionsPerTick=1000
+ *   -Output=EcsactBenchmark.json
+ * ```
+ *
+ * Options:
+ *  -Entities=N        entities created in the bulk create scenario
+ *  -Component=ID      component every entity is created with and updated in
+ *                     the update scenario (optional)
+ *  -UpdatesPerTick=N  component updates pushed every tick in the update
+ *                     scenario
+ *  -Ticks=N           ticks executed in the update and action scenarios
+ *  -Action=ID         action id pushed in the action scenario (optional)
+ *  -ActionsPerTick=N  actions pushed every tick in the action scenario
+ *  -Runtime=PATH      runtime library to load instead of the configured one
+ *                     (e.g. Dist/EcsactMockRuntime-Win64.dll built from
+ *                     Tools/EcsactMockRuntime)
+ *  -Replay=PATH       execution recording to replay as fast as possible
+ *  -Output=PATH       file to write the JSON report to (logged otherwise)
+ *
+ * Memory is reported per scenario relative to the physical memory in use when
+ * it started. peak_used_physical_delta is sampled after every tick. Run with
+ * `-llm` to also report llm_tracked_bytes_per_tick, the change in memory
+ * tracked by LLM across the whole process.
+ */
+UCLASS()
+
+class UEcsactBenchmarkCommandlet : public UCommandlet {
+	GENERATED_BODY() // NOLINT
+
+public:
+	UEcsactBenchmarkCommandlet();
+
+	auto Main(const FString& Params) -> int32 override;
+};
@@ -5,9 +5,11 @@
 // online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
 
 #include "Ecsact.h"
+#include "Async/Async.h"
 #include "CoreGlobals.h"
 #include "EcsactUnreal/EcsactSettings.h"
 #include "Engine/World.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformProcess.h"
 #include "Logging/LogVerbosity.h"
 #include "Misc/Paths.h"
@@ -27,6 +29,76 @@ FOR_EACH_ECSACT_SI_WASM_API_FN(INIT_ECSACT_API_FN, UNUSED_PARAM);
 
 FEcsactModule* FEcsactModule::Self = nullptr;
 
+#if WITH_EDITOR
+static auto HotReloadDir() -> FString {
+	return FPaths::Combine(
+		FPaths::ProjectIntermediateDir(),
+		TEXT("Ecsact"),
+		TEXT("HotReload")
+	);
+}
+
+/**
+ * Hot reloaded runtime copies mapped into the editor before a warning is
+ * logged on every reload. Copies are never freed (see FreeRuntimeHandle).
+ */
+static constexpr auto HotReloadCopyWarningCount = 16;
+
+/**
+ * Copies the runtime library to a unique path before loading it so the
+ * original stays writable for the next build and every load picks up a fresh
+ * library instead of the one already mapped into the process.
+ */
+static auto CopyRuntimeForHotReload(const FString& RuntimePath) -> FString {
+	static auto copy_count = 0;
+
+	if(!FPaths::FileExists(RuntimePath)) {
+		return RuntimePath;
+	}
+
+	copy_count += 1;
+	auto versioned_path = FPaths::Combine(
+		HotReloadDir(),
+		FString::Printf(
+			TEXT("%s-%u-%i%s"),
+			*FPaths::GetBaseFilename(RuntimePath),
+			FPlatformProcess::GetCurrentProcessId(),
+			copy_count,
+			*FPaths::GetExtension(RuntimePath, true)
+		)
+	);
+
+	if(IFileManager::Get().Copy(*versioned_path, *RuntimePath) != COPY_OK) {
+		UE_LOG(
+			Ecsact,
+			Warning,
+			TEXT("Failed to copy %s for hot reload. Loading it in place."),
+			*RuntimePath
+		);
+		return RuntimePath;
+	}
+
+	if(copy_count > HotReloadCopyWarningCount) {
+		UE_LOG(
+			Ecsact,
+			Warning,
+			TEXT("%i Ecsact runtime copies are loaded in this editor session. "
+					 "Restart the editor to release them."),
+			copy_count
+		);
+	} else {
+		UE_LOG(
+			Ecsact,
+			Log,
+			TEXT("Loading Ecsact runtime copy %i of this editor session"),
+			copy_count
+		);
+	}
+
+	return versioned_path;
+}
+#endif
+
 auto FEcsactModule::Get() -> FEcsactModule& {
 	if(GIsEditor) {
 		return FModuleManager::Get().GetModuleChecked<FEcsactModule>("Ecsact");
@@ -51,10 +123,32 @@ auto FEcsactModule::Abort() -> void {
 auto FEcsactModule::StartupModule() -> void {
 	UE_LOG(Ecsact, Log, TEXT("Ecsact Module Startup"));
 	Self = this;
+
+#if WITH_EDITOR
+	if(GIsEditor) {
+		// Copies still loaded by another editor instance will fail to delete
+		IFileManager::Get().DeleteDirectory(*HotReloadDir(), false, true);
+	}
+#endif
+
+	const auto* settings = GetDefault<UEcsactSettings>();
+	if(!GIsEditor && settings->bPreloadRuntimeLibrary) {
+		PreloadedRuntimePath = settings->GetEcsactRuntimeLibraryPath();
+		PreloadedRuntimeDllHandle = Async(
+			EAsyncExecution::Thread,
+			[Path = PreloadedRuntimePath]() -> void* {
+				return FPlatformProcess::GetDllHandle(*Path);
+			}
+		);
+	}
 }
 
 auto FEcsactModule::ShutdownModule() -> void {
 	UE_LOG(Ecsact, Log, TEXT("Ecsact Module Shutdown"));
+	if(PreloadedRuntimeDllHandle.IsValid()) {
+		PreloadedRuntimeDllHandle.Wait();
+		PreloadedRuntimeDllHandle.Reset();
+	}
 	Self = nullptr;
 }
 
@@ -71,6 +165,8 @@ auto FEcsactModule::FreeRuntimeHandle(FEcsactRuntimeHandle& Handle) -> void {
 		// NOTE: Freeing the ecsact runtime causes unreal editor to crash
 		// FPlatformProcess::FreeDllHandle(Handle.DllHandle);
 		Handle.DllHandle = nullptr;
+		// Allows the next ECSACT_LOAD_RUNTIME() e.g. from ReloadRuntime()
+		EcsactRuntimeHandle = nullptr;
 	}
 }
 
@@ -84,7 +180,29 @@ auto EcsactUnreal::Detail::GetDefaultRuntimeDllHandle() -> void* {
 	const auto* settings = GetDefault<UEcsactSettings>();
 
 	auto runtime_path = settings->GetEcsactRuntimeLibraryPath();
-	auto dll_handle = FPlatformProcess::GetDllHandle(*runtime_path);
+	auto dll_handle = static_cast<void*>(nullptr);
+
+	auto& module = FEcsactModule::Get();
+	if(module.PreloadedRuntimeDllHandle.IsValid()) {
+		auto preloaded = module.PreloadedRuntimeDllHandle.Get();
+		module.PreloadedRuntimeDllHandle.Reset();
+		if(module.PreloadedRuntimePath == runtime_path) {
+			dll_handle = preloaded;
+		} else if(preloaded) {
+			// Settings changed since boot. Don't keep a second runtime mapped.
+			FPlatformProcess::FreeDllHandle(preloaded);
+		}
+	}
+
+	if(!dll_handle) {
+		auto load_path = runtime_path;
+#if WITH_EDITOR
+		if(GIsEditor) {
+			load_path = CopyRuntimeForHotReload(runtime_path);
+		}
+#endif
+		dll_handle = FPlatformProcess::GetDllHandle(*load_path);
+	}
 	if(!dll_handle) {
 		UE_LOG(
 			Ecsact,
@@ -96,6 +214,21 @@ auto EcsactUnreal::Detail::GetDefaultRuntimeDllHandle() -> void* {
 	return dll_handle;
 }
 
+auto EcsactUnreal::Detail::LogRuntimeLoaded(
+	int32  LoadedCount,
+	int32  TotalCount,
+	double StartTime
+) -> void {
+	UE_LOG(
+		Ecsact,
+		Log,
+		TEXT("Loaded %i/%i Ecsact runtime functions in %.2fms"),
+		LoadedCount,
+		TotalCount,
+		(FPlatformTime::Seconds() - StartTime) * 1000.0
+	);
+}
+
 auto EcsactUnreal::Detail::CheckRuntimeNotLoaded( //
 	FEcsactModule& Module
 ) -> bool {
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
 #include "Engine/World.h"
 #include "Modules/ModuleManager.h"
 #include "UObject/WeakObjectPtr.h"
@@ -18,6 +19,8 @@ namespace EcsactUnreal::Detail {
 auto CheckRuntimeNotLoaded(FEcsactModule&) -> bool;
 auto CheckRuntimeHandle(FEcsactModule&, const FEcsactRuntimeHandle&) -> bool;
 auto GetDefaultRuntimeDllHandle() -> void*;
+auto LogRuntimeLoaded(int32 LoadedCount, int32 TotalCount, double StartTime)
+	-> void;
 
 auto CheckUnloadable(FEcsactModule&, const FEcsactRuntimeHandle&) -> bool;
 auto UnloadPostDisconnect(FEcsactModule&, FEcsactRuntimeHandle&) -> void;
@@ -36,7 +39,11 @@ class FEcsactModule : public IModuleInterface {
 	// clang-format on
 
 	static FEcsactModule* Self;
-	void*                 EcsactRuntimeHandle;
+	void*                 EcsactRuntimeHandle = nullptr;
+
+	/** Runtime library being loaded on a background thread during boot. */
+	TFuture<void*> PreloadedRuntimeDllHandle;
+	FString        PreloadedRuntimePath;
 
 	auto Abort() -> void;
 
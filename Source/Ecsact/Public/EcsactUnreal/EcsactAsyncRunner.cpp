@@ -6,6 +6,7 @@
 
 #include "EcsactUnreal/EcsactAsyncRunner.h"
 #include "EcsactUnreal/Ecsact.h"
+#include "EcsactUnreal/EcsactMemory.h"
 #include <span>
 #include "EcsactUnreal/EcsactUnrealExecutionOptions.h"
 #include "EcsactUnreal/EcsactRunnerSubsystem.h"
@@ -88,10 +89,34 @@ auto UEcsactAsyncRunner::AsyncSessionStart( //
 		AsyncSessionStop();
 	}
 
+	if(options != SessionStartOptions.GetData()) {
+		SessionStartOptions = TArray<uint8>( //
+			static_cast<const uint8*>(options),
+			options != nullptr ? options_size : 0
+		);
+	}
+
 	SessionId = ecsact_async_start(options, options_size);
 	sessions.Add(SessionId, this);
 }
 
+auto UEcsactAsyncRunner::PreRuntimeReload() -> void {
+	bRestartSessionOnReload = SessionId != ECSACT_INVALID_ID(async_session);
+	Super::PreRuntimeReload();
+}
+
+auto UEcsactAsyncRunner::PostRuntimeReload() -> void {
+	Super::PostRuntimeReload();
+
+	if(bRestartSessionOnReload) {
+		bRestartSessionOnReload = false;
+		AsyncSessionStart(
+			SessionStartOptions.GetData(),
+			SessionStartOptions.Num()
+		);
+	}
+}
+
 auto UEcsactAsyncRunner::AsyncSessionStop() -> void {
 	if(SessionId != ECSACT_INVALID_ID(async_session)) {
 		if(ecsact_async_stop) {
@@ -109,6 +134,21 @@ auto UEcsactAsyncRunner::AsyncSessionStop() -> void {
 	}
 }
 
+auto UEcsactAsyncRunner::StartRecording(const FString& Path) -> bool {
+	if(GetAsyncSessionTick() > 0) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("Cannot record %s - recordings replay from an empty registry and "
+					 "the async session has already ticked"),
+			*Path
+		);
+		return false;
+	}
+
+	return Super::StartRecording(Path);
+}
+
 auto UEcsactAsyncRunner::GetAsyncSessionTick() const -> int32 {
 	if(SessionId != ECSACT_INVALID_ID(async_session)) {
 		if(ecsact_async_get_current_tick) {
@@ -248,6 +288,7 @@ auto UEcsactAsyncRunner::Tick(float DeltaTime) -> void {
 		return;
 	}
 
+	UpdateMemoryStats();
 	EnqueueExecutionOptions();
 
 	if(ecsact_async_flush_events == nullptr) {
@@ -271,6 +312,8 @@ auto UEcsactAsyncRunner::EnqueueExecutionOptions() -> void {
 	}
 
 	if(ExecutionOptions->IsNotEmpty()) {
+		// Recorded at the session's tick so replays match the server's ticks
+		RecordExecutionOptions(GetAsyncSessionTick());
 		auto req_id = ecsact_async_enqueue_execution_options(
 			SessionId,
 			*ExecutionOptions->GetCPtr()
@@ -297,6 +340,7 @@ auto UEcsactAsyncRunner::OnRequestDone(
 		TEXT("Adding request done handler (req=%i)"),
 		static_cast<int>(RequestId)
 	);
+	LLM_SCOPE_BYTAG(Ecsact_Callbacks);
 	RequestDoneCallbacks.FindOrAdd(RequestId).Add(Callback);
 }
 
@@ -305,5 +349,30 @@ auto UEcsactAsyncRunner::OnRequestError(
 	FAsyncRequestErrorCallback Callback
 ) -> void {
 	check(RequestId != ECSACT_INVALID_ID(async_request));
+	LLM_SCOPE_BYTAG(Ecsact_Callbacks);
 	RequestErrorCallbacks.FindOrAdd(RequestId).Add(Callback);
 }
+
+auto UEcsactAsyncRunner::GetPendingCallbacksAllocatedSize() const -> SIZE_T {
+	auto size = Super::GetPendingCallbacksAllocatedSize() +
+		RequestDoneCallbacks.GetAllocatedSize() +
+		RequestErrorCallbacks.GetAllocatedSize();
+	for(const auto& entry : RequestDoneCallbacks) {
+		size += entry.Value.GetAllocatedSize();
+	}
+	for(const auto& entry : RequestErrorCallbacks) {
+		size += entry.Value.GetAllocatedSize();
+	}
+	return size;
+}
+
+auto UEcsactAsyncRunner::GetPendingCallbacksNum() const -> int32 {
+	auto num = Super::GetPendingCallbacksNum();
+	for(const auto& entry : RequestDoneCallbacks) {
+		num += entry.Value.Num();
+	}
+	for(const auto& entry : RequestErrorCallbacks) {
+		num += entry.Value.Num();
+	}
+	return num;
+}
@@ -32,6 +32,10 @@ class ECSACT_API UEcsactAsyncRunner //
 	ecsact_async_events_collector async_evc;
 
 	ecsact_async_session_id SessionId = ECSACT_INVALID_ID(async_session);
+
+	/** Options last given to AsyncSessionStart, reused on runtime reload. */
+	TArray<uint8> SessionStartOptions;
+	bool          bRestartSessionOnReload = false;
 	TMap<ecsact_async_request_id, TArray<FAsyncRequestDoneCallback>>
 		RequestDoneCallbacks;
 	TMap<ecsact_async_request_id, TArray<FAsyncRequestErrorCallback>>
@@ -90,6 +94,18 @@ public:
 	auto GetStatId() const -> TStatId override;
 	auto Stop() -> void override;
 
+	auto PreRuntimeReload() -> void override;
+	auto PostRuntimeReload() -> void override;
+
+	auto GetPendingCallbacksAllocatedSize() const -> SIZE_T override;
+	auto GetPendingCallbacksNum() const -> int32 override;
+
+	/**
+	 * Fails once the async session has ticked. Start recording before
+	 * AsyncSessionStart to record a whole session.
+	 */
+	auto StartRecording(const FString& Path) -> bool override;
+
 	/**
 	 * Usually execution options are enqueued during `Tick`, but if you'd prefer
 	 * to enqueue them earlier then you can call this function to immediate
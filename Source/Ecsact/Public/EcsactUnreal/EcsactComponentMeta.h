@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <array>
+#include <string_view>
+#include "ecsact/runtime/common.h"
+
+namespace EcsactUnreal {
+
+/**
+ * 32-bit FNV-1a hash of an Ecsact declaration's full name (e.g.
+ * "example.Position"). Matches FEcsactComponentMeta::NameHash.
+ */
+constexpr auto EcsactNameHash(std::string_view Name) -> uint32 {
+	auto hash = uint32{2166136261u};
+	for(auto c : Name) {
+		hash ^= static_cast<uint8>(c);
+		hash *= uint32{16777619u};
+	}
+	return hash;
+}
+
+/**
+ * Compile time description of an Ecsact component. Generated headers declare
+ * a table of these for every package as
+ * EcsactUnreal::CodegenMeta::<Package>Components.
+ */
+struct FEcsactComponentMeta {
+	ecsact_component_id Id;
+
+	/** Size of the C++ component struct. 0 for tag components. */
+	int32 Size;
+	int32 Alignment;
+	int32 FieldCount;
+
+	/** Component has no fields and only marks an entity. */
+	bool bTag;
+	bool bTransient;
+
+	uint32      NameHash;
+	const char* FullName;
+};
+
+/**
+ * Finds @p Id in a generated component table. Returns nullptr if the
+ * component isn't part of the table's package.
+ */
+template<std::size_t N>
+constexpr auto FindComponentMeta(
+	const std::array<FEcsactComponentMeta, N>& Table,
+	ecsact_component_id                        Id
+) -> const FEcsactComponentMeta* {
+	for(const auto& meta : Table) {
+		if(meta.Id == Id) {
+			return &meta;
+		}
+	}
+	return nullptr;
+}
+
+} // namespace EcsactUnreal
@@ -0,0 +1,128 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EcsactUnreal/EcsactMemory.h"
+#include "ecsact/runtime/common.h"
+
+/**
+ * Sparse set of Ecsact component values keyed by `ecsact_entity_id`. Lookups
+ * are a single index into the sparse array and values are stored densely so
+ * iteration is cache friendly.
+ */
+template<typename C>
+class TEcsactComponentSparseSet {
+	TArray<int32>            Sparse;
+	TArray<ecsact_entity_id> DenseEntities;
+	TArray<C>                Dense;
+
+	auto DenseIndex(ecsact_entity_id Entity) const -> int32 {
+		auto entity_index = static_cast<int32>(Entity);
+		if(!Sparse.IsValidIndex(entity_index)) {
+			return INDEX_NONE;
+		}
+		return Sparse[entity_index];
+	}
+
+public:
+	auto Contains(ecsact_entity_id Entity) const -> bool {
+		return DenseIndex(Entity) != INDEX_NONE;
+	}
+
+	auto Find(ecsact_entity_id Entity) const -> const C* {
+		auto index = DenseIndex(Entity);
+		if(index == INDEX_NONE) {
+			return nullptr;
+		}
+		return &Dense[index];
+	}
+
+	auto Set(ecsact_entity_id Entity, const C& Component) -> void {
+		LLM_SCOPE_BYTAG(Ecsact_Subsystems);
+		auto entity_index = static_cast<int32>(Entity);
+		if(Sparse.Num() <= entity_index) {
+			auto prev_num = Sparse.Num();
+			Sparse.SetNumUninitialized(entity_index + 1);
+			for(auto i = prev_num; Sparse.Num() > i; ++i) {
+				Sparse[i] = INDEX_NONE;
+			}
+		}
+
+		auto& index = Sparse[entity_index];
+		if(index == INDEX_NONE) {
+			index = Dense.Add(Component);
+			DenseEntities.Add(Entity);
+		} else {
+			Dense[index] = Component;
+		}
+	}
+
+	auto Remove(ecsact_entity_id Entity) -> void {
+		auto index = DenseIndex(Entity);
+		if(index == INDEX_NONE) {
+			return;
+		}
+
+		auto last_entity = DenseEntities.Last();
+		Dense.RemoveAtSwap(index, 1, EAllowShrinking::No);
+		DenseEntities.RemoveAtSwap(index, 1, EAllowShrinking::No);
+		if(last_entity != Entity) {
+			Sparse[static_cast<int32>(last_entity)] = index;
+		}
+		Sparse[static_cast<int32>(Entity)] = INDEX_NONE;
+	}
+
+	auto Reset() -> void {
+		Sparse.Reset();
+		DenseEntities.Reset();
+		Dense.Reset();
+	}
+
+	auto Num() const -> int32 {
+		return Dense.Num();
+	}
+
+	auto GetEntities() const -> TConstArrayView<ecsact_entity_id> {
+		return DenseEntities;
+	}
+
+	auto GetComponents() const -> TConstArrayView<C> {
+		return Dense;
+	}
+};
+
+namespace EcsactUnreal {
+/**
+ * Calls @p Fn with every entity that has all of the given components. The
+ * dense storage of @p First is iterated so pass the rarest component first.
+ *
+ * @example
+ * ```cpp
+ * EcsactUnreal::ForEachComponents(
+ *   [](ecsact_entity_id Entity, const Position& Pos, const Velocity& Vel) {},
+ *   PositionSet,
+ *   VelocitySet
+ * );
+ * ```
+ */
+template<typename Fn, typename First, typename... Rest>
+auto ForEachComponents(
+	Fn&&                                    Callback,
+	const TEcsactComponentSparseSet<First>& FirstSet,
+	const TEcsactComponentSparseSet<Rest>&... RestSets
+) -> void {
+	auto entities = FirstSet.GetEntities();
+	auto components = FirstSet.GetComponents();
+	for(auto i = 0; entities.Num() > i; ++i) {
+		auto entity = entities[i];
+		if((RestSets.Contains(entity) && ...)) {
+			Callback(entity, components[i], *RestSets.Find(entity)...);
+		}
+	}
+}
+} // namespace EcsactUnreal
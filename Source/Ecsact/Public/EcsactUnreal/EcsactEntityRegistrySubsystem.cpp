@@ -0,0 +1,129 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#include "EcsactUnreal/EcsactEntityRegistrySubsystem.h"
+#include "EcsactUnreal/EcsactExecution.h"
+#include "EcsactUnreal/EcsactRunner.h"
+#include "EcsactUnreal/Ecsact.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+
+auto UEcsactEntityRegistrySubsystem::Get( //
+	const UObject* WorldContext
+) -> UEcsactEntityRegistrySubsystem* {
+	if(!WorldContext) {
+		return nullptr;
+	}
+	auto runner = EcsactUnrealExecution::Runner(WorldContext->GetWorld());
+	if(!runner.IsValid()) {
+		return nullptr;
+	}
+	return runner->GetSubsystem<UEcsactEntityRegistrySubsystem>();
+}
+
+auto UEcsactEntityRegistrySubsystem::Bind( //
+	int32    Entity,
+	UObject* Object
+) -> void {
+	if(Entity < 0) {
+		UE_LOG(Ecsact, Error, TEXT("Cannot bind invalid entity %i"), Entity);
+		return;
+	}
+
+	if(!BoundObjects.IsValidIndex(Entity)) {
+		BoundObjects.SetNum(Entity + 1);
+	}
+
+	auto& bound_object = BoundObjects[Entity];
+	if(bound_object.IsExplicitlyNull()) {
+		BoundCount += 1;
+	}
+	bound_object = Object;
+	if(bound_object.IsExplicitlyNull()) {
+		BoundCount -= 1;
+	}
+}
+
+auto UEcsactEntityRegistrySubsystem::Unbind(int32 Entity) -> void {
+	if(!BoundObjects.IsValidIndex(Entity)) {
+		return;
+	}
+
+	auto& bound_object = BoundObjects[Entity];
+	if(!bound_object.IsExplicitlyNull()) {
+		bound_object.Reset();
+		BoundCount -= 1;
+	}
+}
+
+auto UEcsactEntityRegistrySubsystem::BindMany(
+	const TArray<int32>&    Entities,
+	const TArray<UObject*>& Objects
+) -> void {
+	if(Entities.Num() != Objects.Num()) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("BindMany called with %i entities and %i objects"),
+			Entities.Num(),
+			Objects.Num()
+		);
+		return;
+	}
+
+	auto max_entity = INDEX_NONE;
+	for(auto entity : Entities) {
+		max_entity = FMath::Max(max_entity, entity);
+	}
+	if(max_entity >= BoundObjects.Num()) {
+		BoundObjects.SetNum(max_entity + 1);
+	}
+
+	for(auto i = 0; Entities.Num() > i; ++i) {
+		Bind(Entities[i], Objects[i]);
+	}
+}
+
+auto UEcsactEntityRegistrySubsystem::UnbindMany( //
+	const TArray<int32>& Entities
+) -> void {
+	for(auto entity : Entities) {
+		Unbind(entity);
+	}
+}
+
+auto UEcsactEntityRegistrySubsystem::GetBoundObject( //
+	int32 Entity
+) const -> UObject* {
+	if(!BoundObjects.IsValidIndex(Entity)) {
+		return nullptr;
+	}
+	return BoundObjects[Entity].Get();
+}
+
+auto UEcsactEntityRegistrySubsystem::GetBoundActor( //
+	int32 Entity
+) const -> AActor* {
+	auto object = GetBoundObject(Entity);
+	if(auto actor = Cast<AActor>(object)) {
+		return actor;
+	}
+	if(auto component = Cast<UActorComponent>(object)) {
+		return component->GetOwner();
+	}
+	return nullptr;
+}
+
+auto UEcsactEntityRegistrySubsystem::GetBoundCount() const -> int32 {
+	return BoundCount;
+}
+
+auto UEcsactEntityRegistrySubsystem::RunnerStop_Implementation( //
+	class UEcsactRunner* Runner
+) -> void {
+	BoundObjects.Empty();
+	BoundCount = 0;
+}
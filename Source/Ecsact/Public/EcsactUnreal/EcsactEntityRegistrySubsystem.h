@@ -0,0 +1,87 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "EcsactUnreal/EcsactRunnerSubsystem.h"
+#include "EcsactEntityRegistrySubsystem.generated.h"
+
+/**
+ * Binds Ecsact entities to the objects (usually an AActor or
+ * UActorComponent) that represent them. Storage is indexed by entity id so a
+ * lookup is a single array index. Bindings are removed when their entity is
+ * destroyed, after every runner subsystem has handled EntityDestroyed, or
+ * when the runner stops.
+ */
+UCLASS()
+
+class ECSACT_API UEcsactEntityRegistrySubsystem
+	: public UEcsactRunnerSubsystem {
+	GENERATED_BODY() // NOLINT
+
+	TArray<TWeakObjectPtr<UObject>> BoundObjects;
+	int32                           BoundCount = 0;
+
+public:
+	/**
+	 * Gets the registry of the runner for @p WorldContext's world. Returns
+	 * nullptr if there is no runner.
+	 */
+	UFUNCTION(
+		BlueprintPure,
+		Category = "Ecsact Runner",
+		Meta = (WorldContext = "WorldContext")
+	)
+	static UEcsactEntityRegistrySubsystem* Get(const UObject* WorldContext);
+
+	/** Binds @p Object to @p Entity replacing any previous binding. */
+	UFUNCTION(BlueprintCallable, Category = "Ecsact Runner")
+	void Bind(int32 Entity, UObject* Object);
+
+	UFUNCTION(BlueprintCallable, Category = "Ecsact Runner")
+	void Unbind(int32 Entity);
+
+	/** Binds Objects[i] to Entities[i]. Both arrays must be the same length. */
+	UFUNCTION(BlueprintCallable, Category = "Ecsact Runner")
+	void BindMany(
+		const TArray<int32>&    Entities,
+		const TArray<UObject*>& Objects
+	);
+
+	UFUNCTION(BlueprintCallable, Category = "Ecsact Runner")
+	void UnbindMany(const TArray<int32>& Entities);
+
+	/**
+	 * Object bound to @p Entity or nullptr if there is none or it has been
+	 * destroyed.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ecsact Runner")
+	UObject* GetBoundObject(int32 Entity) const;
+
+	/**
+	 * Actor bound to @p Entity. If a component is bound its owner is returned.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ecsact Runner")
+	AActor* GetBoundActor(int32 Entity) const;
+
+	/** Number of entities with a binding, including destroyed objects. */
+	UFUNCTION(BlueprintPure, Category = "Ecsact Runner")
+	int32 GetBoundCount() const;
+
+	/**
+	 * Object bound to @p Entity if it is a @p T.
+	 */
+	template<typename T>
+	auto GetBound(int32 Entity) const -> T* {
+		return Cast<T>(GetBoundObject(Entity));
+	}
+
+	auto RunnerStop_Implementation( //
+		class UEcsactRunner* Runner
+	) -> void override;
+};
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#include "EcsactUnreal/EcsactEventPlaybackRunner.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "EcsactUnreal/Ecsact.h"
+#include "EcsactUnreal/EcsactEventRecording.h"
+
+namespace {
+constexpr auto FileHeaderSize = int64{sizeof(uint32) * 2};
+} // namespace
+
+UEcsactEventPlaybackRunner::UEcsactEventPlaybackRunner() = default;
+
+UEcsactEventPlaybackRunner::~UEcsactEventPlaybackRunner() = default;
+
+auto UEcsactEventPlaybackRunner::Open(const FString& Path) -> bool {
+	Close();
+
+	auto& platform_file = FPlatformFileManager::Get().GetPlatformFile();
+	MappedFile.Reset(platform_file.OpenMapped(*Path));
+	if(!MappedFile) {
+		UE_LOG(Ecsact, Error, TEXT("Failed to map %s"), *Path);
+		return false;
+	}
+
+	MappedRegion.Reset(MappedFile->MapRegion());
+	if(!MappedRegion || MappedRegion->GetMappedSize() < FileHeaderSize) {
+		UE_LOG(Ecsact, Error, TEXT("%s is not an Ecsact event recording"), *Path);
+		Close();
+		return false;
+	}
+
+	uint32 header[2];
+	FMemory::Memcpy(header, MappedRegion->GetMappedPtr(), sizeof(header));
+	if(header[0] != FEcsactEventRecorder::Magic ||
+		 header[1] != FEcsactEventRecorder::Version) {
+		UE_LOG(Ecsact, Error, TEXT("%s is not an Ecsact event recording"), *Path);
+		Close();
+		return false;
+	}
+
+	Offset = FileHeaderSize;
+	PlaybackStartTime = -1.0;
+	return true;
+}
+
+auto UEcsactEventPlaybackRunner::Close() -> void {
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	Offset = 0;
+}
+
+auto UEcsactEventPlaybackRunner::IsFinished() const -> bool {
+	return !MappedRegion || Offset >= MappedRegion->GetMappedSize();
+}
+
+auto UEcsactEventPlaybackRunner::Dispatch(double UntilTime) -> int64 {
+	if(!MappedRegion) {
+		return 0;
+	}
+
+	return EcsactUnreal::DispatchRecordedEvents(
+		MappedRegion->GetMappedPtr(),
+		MappedRegion->GetMappedSize(),
+		Offset,
+		UntilTime,
+		GetEventsCollector()
+	);
+}
+
+auto UEcsactEventPlaybackRunner::PlayAll() -> int64 {
+	return Dispatch(TNumericLimits<double>::Max());
+}
+
+auto UEcsactEventPlaybackRunner::Stop() -> void {
+	Close();
+	Super::Stop();
+}
+
+auto UEcsactEventPlaybackRunner::Tick(float DeltaTime) -> void {
+	if(IsFinished()) {
+		return;
+	}
+
+	if(!bOriginalSpeed) {
+		PlayAll();
+		return;
+	}
+
+	auto now = FPlatformTime::Seconds();
+	if(PlaybackStartTime < 0.0) {
+		PlaybackStartTime = now;
+	}
+	Dispatch(now - PlaybackStartTime);
+}
+
+auto UEcsactEventPlaybackRunner::GetStatId() const -> TStatId {
+	RETURN_QUICK_DECLARE_CYCLE_STAT( // NOLINT
+		UEcsactEventPlaybackRunner,
+		STATGROUP_Tickables
+	);
+}
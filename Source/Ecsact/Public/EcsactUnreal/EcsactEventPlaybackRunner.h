@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "EcsactUnreal/EcsactRunner.h"
+#include "EcsactEventPlaybackRunner.generated.h"
+
+/**
+ * Drives runner subsystems from a file written by
+ * UEcsactRunner::StartEventRecording without an Ecsact runtime. The file is
+ * memory mapped and payloads are handed to subsystems in place.
+ */
+UCLASS(NotBlueprintable)
+
+class ECSACT_API UEcsactEventPlaybackRunner : public UEcsactRunner {
+	GENERATED_BODY() // NOLINT
+
+	TUniquePtr<class IMappedFileHandle> MappedFile;
+	TUniquePtr<class IMappedFileRegion> MappedRegion;
+
+	int64  Offset = 0;
+	double PlaybackStartTime = -1.0;
+
+	/**
+	 * Dispatches events until a frame recorded after @p UntilTime is reached.
+	 * Returns the number of events dispatched.
+	 */
+	auto Dispatch(double UntilTime) -> int64;
+
+public:
+	/**
+	 * When set frames are dispatched at the rate they were recorded. Otherwise
+	 * the entire recording is dispatched on the next tick.
+	 */
+	bool bOriginalSpeed = true;
+
+	UEcsactEventPlaybackRunner();
+	~UEcsactEventPlaybackRunner();
+
+	auto Open(const FString& Path) -> bool;
+	auto Close() -> void;
+	auto IsFinished() const -> bool;
+
+	/**
+	 * Dispatches every remaining event immediately. Returns the number of events
+	 * dispatched.
+	 */
+	auto PlayAll() -> int64;
+
+	auto Stop() -> void override;
+	auto Tick(float DeltaTime) -> void override;
+	auto GetStatId() const -> TStatId override;
+};
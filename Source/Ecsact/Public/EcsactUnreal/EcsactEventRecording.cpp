@@ -0,0 +1,316 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#include "EcsactUnreal/EcsactEventRecording.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Serialization/MemoryWriter.h"
+#include "EcsactUnreal/Ecsact.h"
+#include "EcsactUnreal/EcsactMemory.h"
+#include "ecsact/runtime/serialize.h"
+
+namespace {
+struct FEventRecordHeader {
+	int32 Event;
+	int32 Entity;
+	int32 Id;
+	int32 Size;
+};
+} // namespace
+
+FEcsactEventRecorder::FEcsactEventRecorder() = default;
+
+FEcsactEventRecorder::~FEcsactEventRecorder() {
+	Close();
+}
+
+auto FEcsactEventRecorder::Open(const FString& Path) -> bool {
+	Close();
+
+	if(ecsact_serialize_component_size == nullptr) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("ecsact_serialize_component_size unavailable - cannot record "
+					 "Ecsact events")
+		);
+		return false;
+	}
+
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*Path));
+	if(!Writer) {
+		UE_LOG(Ecsact, Error, TEXT("Failed to open %s for recording"), *Path);
+		return false;
+	}
+
+	auto magic = Magic;
+	auto version = Version;
+	*Writer << magic;
+	*Writer << version;
+
+	ComponentSizes.Reset();
+	LastFrameCounter = 0;
+	StartTime = FPlatformTime::Seconds();
+	bWriteFrames = true;
+	return true;
+}
+
+auto FEcsactEventRecorder::OpenMemory(TArray<uint8>& Buffer) -> bool {
+	Close();
+
+	if(ecsact_serialize_component_size == nullptr) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("ecsact_serialize_component_size unavailable - cannot record "
+					 "Ecsact events")
+		);
+		return false;
+	}
+
+	// Component sizes are kept since memory recorders are usually reopened
+	// every tick
+	Writer = MakeUnique<FMemoryWriter>(Buffer);
+	bWriteFrames = false;
+	return true;
+}
+
+auto FEcsactEventRecorder::MakeEventsCollector()
+	-> ecsact_execution_events_collector {
+	auto component_callback = [](
+		ecsact_event        event,
+		ecsact_entity_id    entity_id,
+		ecsact_component_id component_id,
+		const void*         component_data,
+		void*               user_data
+	) {
+		static_cast<FEcsactEventRecorder*>(user_data)
+			->RecordComponent(event, entity_id, component_id, component_data);
+	};
+	auto entity_callback = [](
+		ecsact_event                 event,
+		ecsact_entity_id             entity_id,
+		ecsact_placeholder_entity_id placeholder_id,
+		void*                        user_data
+	) {
+		static_cast<FEcsactEventRecorder*>(user_data)
+			->RecordEntity(event, entity_id, placeholder_id);
+	};
+
+	return ecsact_execution_events_collector{
+		.init_callback = component_callback,
+		.init_callback_user_data = this,
+		.update_callback = component_callback,
+		.update_callback_user_data = this,
+		.remove_callback = component_callback,
+		.remove_callback_user_data = this,
+		.entity_created_callback = entity_callback,
+		.entity_created_callback_user_data = this,
+		.entity_destroyed_callback = entity_callback,
+		.entity_destroyed_callback_user_data = this,
+	};
+}
+
+auto FEcsactEventRecorder::Close() -> void {
+	if(Writer) {
+		Writer->Close();
+		Writer.Reset();
+	}
+}
+
+auto FEcsactEventRecorder::IsOpen() const -> bool {
+	return Writer.IsValid();
+}
+
+auto FEcsactEventRecorder::WriteRecord(
+	int32       Event,
+	int32       Entity,
+	int32       Id,
+	const void* Payload,
+	int32       PayloadSize
+) -> void {
+	static const uint8 padding[sizeof(int32)] = {};
+
+	LLM_SCOPE_BYTAG(Ecsact_Recording);
+	*Writer << Event;
+	*Writer << Entity;
+	*Writer << Id;
+	*Writer << PayloadSize;
+	if(PayloadSize > 0) {
+		Writer->Serialize(const_cast<void*>(Payload), PayloadSize);
+		auto padding_size = Align(PayloadSize, sizeof(int32)) - PayloadSize;
+		Writer->Serialize(const_cast<uint8*>(padding), padding_size);
+	}
+}
+
+auto FEcsactEventRecorder::MaybeWriteFrame() -> void {
+	if(!bWriteFrames || LastFrameCounter == GFrameCounter) {
+		return;
+	}
+	LastFrameCounter = GFrameCounter;
+
+	auto time = FPlatformTime::Seconds() - StartTime;
+	WriteRecord(FrameEvent, 0, 0, &time, sizeof(time));
+}
+
+auto FEcsactEventRecorder::GetComponentSize( //
+	ecsact_component_id ComponentId
+) -> int32 {
+	auto key = static_cast<int32>(ComponentId);
+	if(auto size = ComponentSizes.Find(key)) {
+		return *size;
+	}
+	auto size = ecsact_serialize_component_size(ComponentId);
+	ComponentSizes.Add(key, size);
+	return size;
+}
+
+auto FEcsactEventRecorder::RecordComponent(
+	ecsact_event        Event,
+	ecsact_entity_id    Entity,
+	ecsact_component_id ComponentId,
+	const void*         ComponentData
+) -> void {
+	if(!Writer || bPaused) {
+		return;
+	}
+
+	MaybeWriteFrame();
+	WriteRecord(
+		static_cast<int32>(Event),
+		static_cast<int32>(Entity),
+		static_cast<int32>(ComponentId),
+		ComponentData,
+		ComponentData ? GetComponentSize(ComponentId) : 0
+	);
+}
+
+auto FEcsactEventRecorder::RecordEntity(
+	ecsact_event                 Event,
+	ecsact_entity_id             Entity,
+	ecsact_placeholder_entity_id PlaceholderId
+) -> void {
+	if(!Writer || bPaused) {
+		return;
+	}
+
+	MaybeWriteFrame();
+	WriteRecord(
+		static_cast<int32>(Event),
+		static_cast<int32>(Entity),
+		static_cast<int32>(PlaceholderId),
+		nullptr,
+		0
+	);
+}
+
+auto EcsactUnreal::DispatchRecordedEvents(
+	const uint8*                             Data,
+	int64                                    DataSize,
+	int64&                                   Offset,
+	double                                   UntilTime,
+	const ecsact_execution_events_collector* EventsCollector,
+	bool                                     bDispatchPlaceholders
+) -> int64 {
+	auto count = int64{};
+
+	while(Offset + static_cast<int64>(sizeof(FEventRecordHeader)) <= DataSize) {
+		auto record = FEventRecordHeader{};
+		FMemory::Memcpy(&record, Data + Offset, sizeof(record));
+
+		auto payload_offset = //
+			Offset + static_cast<int64>(sizeof(FEventRecordHeader));
+		auto next_offset = payload_offset + Align(record.Size, sizeof(int32));
+		if(record.Size < 0 || next_offset > DataSize) {
+			UE_LOG(
+				Ecsact,
+				Error,
+				TEXT("Ecsact event recording is truncated at byte %lld"),
+				Offset
+			);
+			Offset = DataSize;
+			break;
+		}
+
+		auto payload = record.Size > 0 ? Data + payload_offset : nullptr;
+
+		if(record.Event == FEcsactEventRecorder::FrameEvent) {
+			auto frame_time = 0.0;
+			if(record.Size >= static_cast<int32>(sizeof(frame_time))) {
+				FMemory::Memcpy(&frame_time, payload, sizeof(frame_time));
+			}
+			if(frame_time > UntilTime) {
+				break;
+			}
+			Offset = next_offset;
+			continue;
+		}
+
+		Offset = next_offset;
+		count += 1;
+
+		auto event = static_cast<ecsact_event>(record.Event);
+		auto entity = static_cast<ecsact_entity_id>(record.Entity);
+		switch(event) {
+			case ECSACT_EVENT_INIT_COMPONENT:
+				EventsCollector->init_callback(
+					event,
+					entity,
+					static_cast<ecsact_component_id>(record.Id),
+					payload,
+					EventsCollector->init_callback_user_data
+				);
+				break;
+			case ECSACT_EVENT_UPDATE_COMPONENT:
+				EventsCollector->update_callback(
+					event,
+					entity,
+					static_cast<ecsact_component_id>(record.Id),
+					payload,
+					EventsCollector->update_callback_user_data
+				);
+				break;
+			case ECSACT_EVENT_REMOVE_COMPONENT:
+				EventsCollector->remove_callback(
+					event,
+					entity,
+					static_cast<ecsact_component_id>(record.Id),
+					payload,
+					EventsCollector->remove_callback_user_data
+				);
+				break;
+			case ECSACT_EVENT_CREATED_ENTITY:
+				// Placeholders belong to the recording session's create callbacks
+				EventsCollector->entity_created_callback(
+					event,
+					entity,
+					bDispatchPlaceholders
+						? static_cast<ecsact_placeholder_entity_id>(record.Id)
+						: ECSACT_INVALID_ID(placeholder_entity),
+					EventsCollector->entity_created_callback_user_data
+				);
+				break;
+			case ECSACT_EVENT_DESTROYED_ENTITY:
+				EventsCollector->entity_destroyed_callback(
+					event,
+					entity,
+					static_cast<ecsact_placeholder_entity_id>(record.Id),
+					EventsCollector->entity_destroyed_callback_user_data
+				);
+				break;
+			default:
+				UE_LOG(
+					Ecsact,
+					Warning,
+					TEXT("Unknown event %i in Ecsact event recording"),
+					record.Event
+				);
+				break;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "ecsact/runtime/common.h"
+
+/**
+ * Appends every event received by a runner's events collector to a file.
+ *
+ * Stream layout (native endian, payloads padded to 4 bytes):
+ *
+ *   header:  magic 'ECEV', version
+ *   record:  event, entity, component id or placeholder id, size, payload
+ *
+ * A record with event FrameEvent is written before the first event of every
+ * engine frame. Its payload is the seconds (double) since recording started.
+ *
+ * Component payload sizes come from `ecsact_serialize_component_size` so the
+ * runtime must export the serialize API.
+ */
+class ECSACT_API FEcsactEventRecorder {
+	TUniquePtr<FArchive> Writer;
+	TMap<int32, int32>   ComponentSizes;
+	uint64               LastFrameCounter = 0;
+	double               StartTime = 0.0;
+	bool                 bWriteFrames = true;
+	bool                 bPaused = false;
+
+	auto WriteRecord(
+		int32       Event,
+		int32       Entity,
+		int32       Id,
+		const void* Payload,
+		int32       PayloadSize
+	) -> void;
+	auto MaybeWriteFrame() -> void;
+	auto GetComponentSize(ecsact_component_id ComponentId) -> int32;
+
+public:
+	static constexpr uint32 Magic = 0x56454345; // 'ECEV'
+	static constexpr uint32 Version = 1;
+	static constexpr int32  FrameEvent = -1;
+
+	FEcsactEventRecorder();
+	~FEcsactEventRecorder();
+
+	auto Open(const FString& Path) -> bool;
+
+	/**
+	 * Records to @p Buffer instead of a file. No header or frame records are
+	 * written. @p Buffer must outlive the recorder or the next Close().
+	 */
+	auto OpenMemory(TArray<uint8>& Buffer) -> bool;
+
+	auto Close() -> void;
+	auto IsOpen() const -> bool;
+
+	/** Events are dropped instead of recorded while paused. */
+	auto SetPaused(bool bInPaused) -> void {
+		bPaused = bInPaused;
+	}
+
+	/**
+	 * Events collector that records every event into this recorder.
+	 */
+	auto MakeEventsCollector() -> ecsact_execution_events_collector;
+
+	auto RecordComponent(
+		ecsact_event        Event,
+		ecsact_entity_id    Entity,
+		ecsact_component_id ComponentId,
+		const void*         ComponentData
+	) -> void;
+
+	auto RecordEntity(
+		ecsact_event                 Event,
+		ecsact_entity_id             Entity,
+		ecsact_placeholder_entity_id PlaceholderId
+	) -> void;
+};
+
+namespace EcsactUnreal {
+/**
+ * Dispatches records written by FEcsactEventRecorder to @p EventsCollector
+ * starting at @p Offset. Stops before the first frame record with a time
+ * greater than @p UntilTime. Returns the number of events dispatched.
+ *
+ * Created entity events are dispatched without their placeholder id since the
+ * create callbacks they belonged to are not pending anymore. Set
+ * @p bDispatchPlaceholders when the events were recorded in this session and
+ * their create callbacks are still pending.
+ */
+ECSACT_API auto DispatchRecordedEvents(
+	const uint8*                             Data,
+	int64                                    DataSize,
+	int64&                                   Offset,
+	double                                   UntilTime,
+	const ecsact_execution_events_collector* EventsCollector,
+	bool                                     bDispatchPlaceholders = false
+) -> int64;
+} // namespace EcsactUnreal
@@ -0,0 +1,456 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#include "EcsactUnreal/EcsactExecutionRecording.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+#include "EcsactUnreal/Ecsact.h"
+#include "EcsactUnreal/EcsactMemory.h"
+#include "EcsactUnreal/EcsactUnrealExecutionOptions.h"
+
+namespace {
+auto AppendInt(TArray<uint8>& Buffer, int32 Value) -> void {
+	Buffer.Append(reinterpret_cast<const uint8*>(&Value), sizeof(int32));
+}
+
+auto AppendPayload( //
+	TArray<uint8>& Buffer,
+	const void*    Data,
+	int32          Size
+) -> void {
+	AppendInt(Buffer, Size);
+	Buffer.Append(static_cast<const uint8*>(Data), Size);
+	auto padding = Align(Size, sizeof(int32)) - Size;
+	Buffer.AddZeroed(padding);
+}
+
+/**
+ * Bounds checked reader over a loaded recording.
+ */
+struct FRecordingReader {
+	const TArray<uint8>& Data;
+	int32                Offset = 0;
+
+	auto ReadInt(int32& Out) -> bool {
+		if(Offset + static_cast<int32>(sizeof(int32)) > Data.Num()) {
+			return false;
+		}
+		FMemory::Memcpy(&Out, Data.GetData() + Offset, sizeof(int32));
+		Offset += sizeof(int32);
+		return true;
+	}
+
+	auto ReadPayload(const void*& Out) -> bool {
+		auto size = int32{};
+		if(!ReadInt(size) || size < 0) {
+			return false;
+		}
+		auto padded_size = Align(size, sizeof(int32));
+		if(Offset + padded_size > Data.Num()) {
+			return false;
+		}
+		Out = Data.GetData() + Offset;
+		Offset += padded_size;
+		return true;
+	}
+};
+
+/**
+ * Indices into the recording's flat arrays. Converted to pointers once every
+ * frame has been decoded and the arrays no longer reallocate.
+ */
+struct FFrameRanges {
+	int32 Actions;
+	int32 AddComponents;
+	int32 AddEntities;
+	int32 UpdateComponents;
+	int32 UpdateEntities;
+	int32 RemoveComponentIds;
+	int32 RemoveEntities;
+	int32 Creates;
+	int32 DestroyEntities;
+};
+} // namespace
+
+FEcsactExecutionRecorder::FEcsactExecutionRecorder() = default;
+
+FEcsactExecutionRecorder::~FEcsactExecutionRecorder() {
+	Close();
+}
+
+auto FEcsactExecutionRecorder::Open(const FString& Path) -> bool {
+	Close();
+	LastRecordedTick = INDEX_NONE;
+
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*Path));
+	if(!Writer) {
+		UE_LOG(Ecsact, Error, TEXT("Failed to open %s for recording"), *Path);
+		return false;
+	}
+
+	auto magic = Magic;
+	auto version = Version;
+	*Writer << magic;
+	*Writer << version;
+	return true;
+}
+
+auto FEcsactExecutionRecorder::OpenMemory(TArray<uint8>& Buffer) -> void {
+	Close();
+	LastRecordedTick = INDEX_NONE;
+	Writer = MakeUnique<FMemoryWriter>(Buffer);
+}
+
+auto FEcsactExecutionRecorder::Close() -> void {
+	if(Writer) {
+		FlushFrame();
+		Writer->Close();
+		Writer.Reset();
+	}
+}
+
+auto FEcsactExecutionRecorder::IsOpen() const -> bool {
+	return Writer.IsValid();
+}
+
+auto FEcsactExecutionRecorder::Record(
+	int32                                Tick,
+	const UEcsactUnrealExecutionOptions& Options
+) -> void {
+	if(!Writer || !Options.IsNotEmpty()) {
+		return;
+	}
+
+	// Frames must be in tick order for replay
+	BeginFrame(FMath::Max(Tick, LastRecordedTick));
+	AppendOptions(Options);
+}
+
+auto FEcsactExecutionRecorder::RecordEnd(int32 TickCount) -> void {
+	if(!Writer || TickCount <= 0 || LastRecordedTick >= TickCount - 1) {
+		return;
+	}
+
+	BeginFrame(TickCount - 1);
+}
+
+auto FEcsactExecutionRecorder::BeginFrame(int32 Tick) -> void {
+	if(PendingTick != Tick) {
+		FlushFrame();
+		PendingTick = Tick;
+		LastRecordedTick = Tick;
+	}
+}
+
+auto FEcsactExecutionRecorder::AppendOptions(
+	const UEcsactUnrealExecutionOptions& Options
+) -> void {
+	LLM_SCOPE_BYTAG(Ecsact_Recording);
+
+	auto& actions = PendingSections[0];
+	PendingCounts[0] += Options.ActionList.Num();
+	for(auto i = 0; Options.ActionList.Num() > i; ++i) {
+		auto& action = Options.ActionList[i];
+		AppendInt(actions, action.action_id);
+		AppendPayload(actions, action.action_data, Options.ActionSizeList[i]);
+	}
+
+	auto& adds = PendingSections[1];
+	PendingCounts[1] += Options.AddComponentList.Num();
+	for(auto i = 0; Options.AddComponentList.Num() > i; ++i) {
+		auto& comp = Options.AddComponentList[i];
+		AppendInt(adds, Options.AddComponentEntityList[i]);
+		AppendInt(adds, comp.component_id);
+		AppendPayload(adds, comp.component_data, Options.AddComponentSizeList[i]);
+	}
+
+	auto& updates = PendingSections[2];
+	PendingCounts[2] += Options.UpdateComponentList.Num();
+	for(auto i = 0; Options.UpdateComponentList.Num() > i; ++i) {
+		auto& comp = Options.UpdateComponentList[i];
+		AppendInt(updates, Options.UpdateComponentEntityList[i]);
+		AppendInt(updates, comp.component_id);
+		AppendPayload(
+			updates,
+			comp.component_data,
+			Options.UpdateComponentSizeList[i]
+		);
+	}
+
+	auto& removes = PendingSections[3];
+	PendingCounts[3] += Options.RemoveComponentList.Num();
+	for(auto i = 0; Options.RemoveComponentList.Num() > i; ++i) {
+		AppendInt(removes, Options.RemoveComponentEntityList[i]);
+		AppendInt(removes, Options.RemoveComponentList[i]);
+	}
+
+	auto& creates = PendingSections[4];
+	PendingCounts[4] += Options.CreateEntityList.Num();
+	for(auto i = 0; Options.CreateEntityList.Num() > i; ++i) {
+		auto& comps = Options.CreateEntityComponentsList[i];
+		auto& sizes = Options.CreateEntityComponentSizesList[i];
+		AppendInt(creates, Options.CreateEntityList[i]);
+		AppendInt(creates, comps.Num());
+		for(auto ci = 0; comps.Num() > ci; ++ci) {
+			AppendInt(creates, comps[ci].component_id);
+			AppendPayload(creates, comps[ci].component_data, sizes[ci]);
+		}
+	}
+
+	auto& destroys = PendingSections[5];
+	PendingCounts[5] += Options.DestroyEntityList.Num();
+	for(auto entity : Options.DestroyEntityList) {
+		AppendInt(destroys, entity);
+	}
+}
+
+auto FEcsactExecutionRecorder::FlushFrame() -> void {
+	if(PendingTick == INDEX_NONE) {
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Ecsact_Recording);
+	auto& buffer = FrameBuffer;
+	buffer.Reset();
+
+	AppendInt(buffer, PendingTick);
+	for(auto i = 0; SectionCount > i; ++i) {
+		AppendInt(buffer, PendingCounts[i]);
+		buffer.Append(PendingSections[i]);
+		PendingSections[i].Reset();
+		PendingCounts[i] = 0;
+	}
+	PendingTick = INDEX_NONE;
+
+	auto frame_length = static_cast<uint32>(buffer.Num());
+	*Writer << frame_length;
+	Writer->Serialize(buffer.GetData(), buffer.Num());
+}
+
+auto FEcsactExecutionRecording::Reset() -> void {
+	Data.Empty();
+	Ticks.Empty();
+	Options.Empty();
+	Actions.Empty();
+	Components.Empty();
+	Entities.Empty();
+	ComponentIds.Empty();
+	Placeholders.Empty();
+	CreateComponentNums.Empty();
+	CreateComponentLists.Empty();
+}
+
+auto FEcsactExecutionRecording::Load(const FString& Path) -> bool {
+	LLM_SCOPE_BYTAG(Ecsact_Recording);
+	Reset();
+
+	if(!FFileHelper::LoadFileToArray(Data, *Path)) {
+		UE_LOG(Ecsact, Error, TEXT("Failed to read recording %s"), *Path);
+		return false;
+	}
+
+	auto reader = FRecordingReader{Data};
+	auto magic = int32{};
+	auto version = int32{};
+	if(!reader.ReadInt(magic) || !reader.ReadInt(version) ||
+		 static_cast<uint32>(magic) != FEcsactExecutionRecorder::Magic ||
+		 static_cast<uint32>(version) != FEcsactExecutionRecorder::Version) {
+		UE_LOG(Ecsact, Error, TEXT("%s is not an Ecsact recording"), *Path);
+		Reset();
+		return false;
+	}
+
+	if(!ParseFrames(reader.Offset)) {
+		UE_LOG(Ecsact, Error, TEXT("Failed to load recording %s"), *Path);
+		return false;
+	}
+
+	return true;
+}
+
+auto FEcsactExecutionRecording::LoadFrames(TArray<uint8> FrameData) -> bool {
+	Reset();
+	Data = MoveTemp(FrameData);
+	return ParseFrames(0);
+}
+
+auto FEcsactExecutionRecording::ParseFrames(int32 StartOffset) -> bool {
+	LLM_SCOPE_BYTAG(Ecsact_Recording);
+	auto reader = FRecordingReader{Data, StartOffset};
+	auto ranges = TArray<FFrameRanges>{};
+	auto create_components_starts = TArray<int32>{};
+
+	auto fail = [&]() -> bool {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("Recording is truncated or corrupt at byte %i"),
+			reader.Offset
+		);
+		Reset();
+		return false;
+	};
+
+	while(reader.Offset < Data.Num()) {
+		auto frame_length = int32{};
+		auto tick = int32{};
+		if(!reader.ReadInt(frame_length)) {
+			return fail();
+		}
+		auto frame_end = reader.Offset + frame_length;
+		if(!reader.ReadInt(tick)) {
+			return fail();
+		}
+
+		auto& opts = Options.AddZeroed_GetRef();
+		auto& range = ranges.AddZeroed_GetRef();
+		Ticks.Add(tick);
+
+		auto count = int32{};
+		if(!reader.ReadInt(count)) {
+			return fail();
+		}
+		opts.actions_length = count;
+		range.Actions = Actions.Num();
+		for(auto i = 0; count > i; ++i) {
+			auto& action = Actions.AddZeroed_GetRef();
+			auto  action_id = int32{};
+			if(!reader.ReadInt(action_id) ||
+				 !reader.ReadPayload(action.action_data)) {
+				return fail();
+			}
+			action.action_id = static_cast<ecsact_action_id>(action_id);
+		}
+
+		auto read_components = [&](
+			int&   OutLength,
+			int32& OutComponents,
+			int32& OutEntities
+		) -> bool {
+			auto length = int32{};
+			if(!reader.ReadInt(length)) {
+				return false;
+			}
+			OutLength = length;
+			OutComponents = Components.Num();
+			OutEntities = Entities.Num();
+			for(auto i = 0; length > i; ++i) {
+				auto entity = int32{};
+				auto component_id = int32{};
+				auto& comp = Components.AddZeroed_GetRef();
+				if(!reader.ReadInt(entity) || !reader.ReadInt(component_id) ||
+					 !reader.ReadPayload(comp.component_data)) {
+					return false;
+				}
+				comp.component_id = static_cast<ecsact_component_id>(component_id);
+				Entities.Add(static_cast<ecsact_entity_id>(entity));
+			}
+			return true;
+		};
+
+		if(!read_components(
+				 opts.add_components_length,
+				 range.AddComponents,
+				 range.AddEntities
+			 )) {
+			return fail();
+		}
+		if(!read_components(
+				 opts.update_components_length,
+				 range.UpdateComponents,
+				 range.UpdateEntities
+			 )) {
+			return fail();
+		}
+
+		if(!reader.ReadInt(count)) {
+			return fail();
+		}
+		opts.remove_components_length = count;
+		range.RemoveEntities = Entities.Num();
+		range.RemoveComponentIds = ComponentIds.Num();
+		for(auto i = 0; count > i; ++i) {
+			auto entity = int32{};
+			auto component_id = int32{};
+			if(!reader.ReadInt(entity) || !reader.ReadInt(component_id)) {
+				return fail();
+			}
+			Entities.Add(static_cast<ecsact_entity_id>(entity));
+			ComponentIds.Add(static_cast<ecsact_component_id>(component_id));
+		}
+
+		if(!reader.ReadInt(count)) {
+			return fail();
+		}
+		opts.create_entities_length = count;
+		range.Creates = Placeholders.Num();
+		for(auto i = 0; count > i; ++i) {
+			auto placeholder = int32{};
+			auto comp_count = int32{};
+			if(!reader.ReadInt(placeholder) || !reader.ReadInt(comp_count)) {
+				return fail();
+			}
+			Placeholders.Add(static_cast<ecsact_placeholder_entity_id>(placeholder));
+			CreateComponentNums.Add(comp_count);
+			create_components_starts.Add(Components.Num());
+			for(auto ci = 0; comp_count > ci; ++ci) {
+				auto component_id = int32{};
+				auto& comp = Components.AddZeroed_GetRef();
+				if(!reader.ReadInt(component_id) ||
+					 !reader.ReadPayload(comp.component_data)) {
+					return fail();
+				}
+				comp.component_id = static_cast<ecsact_component_id>(component_id);
+			}
+		}
+
+		if(!reader.ReadInt(count)) {
+			return fail();
+		}
+		opts.destroy_entities_length = count;
+		range.DestroyEntities = Entities.Num();
+		for(auto i = 0; count > i; ++i) {
+			auto entity = int32{};
+			if(!reader.ReadInt(entity)) {
+				return fail();
+			}
+			Entities.Add(static_cast<ecsact_entity_id>(entity));
+		}
+
+		if(reader.Offset != frame_end) {
+			return fail();
+		}
+	}
+
+	CreateComponentLists.SetNumUninitialized(create_components_starts.Num());
+	for(auto i = 0; create_components_starts.Num() > i; ++i) {
+		CreateComponentLists[i] =
+			Components.GetData() + create_components_starts[i];
+	}
+
+	for(auto i = 0; Options.Num() > i; ++i) {
+		auto& opts = Options[i];
+		auto& range = ranges[i];
+		opts.actions = Actions.GetData() + range.Actions;
+		opts.add_components_entities = Entities.GetData() + range.AddEntities;
+		opts.add_components = Components.GetData() + range.AddComponents;
+		opts.update_components_entities = //
+			Entities.GetData() + range.UpdateEntities;
+		opts.update_components = Components.GetData() + range.UpdateComponents;
+		opts.remove_components_entities = //
+			Entities.GetData() + range.RemoveEntities;
+		opts.remove_components = ComponentIds.GetData() + range.RemoveComponentIds;
+		opts.create_entities = Placeholders.GetData() + range.Creates;
+		opts.create_entities_components_length = //
+			CreateComponentNums.GetData() + range.Creates;
+		opts.create_entities_components = //
+			CreateComponentLists.GetData() + range.Creates;
+		opts.destroy_entities = Entities.GetData() + range.DestroyEntities;
+	}
+
+	return true;
+}
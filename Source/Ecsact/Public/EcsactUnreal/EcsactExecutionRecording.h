@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "ecsact/runtime/common.h"
+
+class UEcsactUnrealExecutionOptions;
+
+/**
+ * Writes submitted execution options to a compact binary stream.
+ *
+ * Stream layout (native endian, every field is 4 bytes and payloads are padded
+ * to 4 bytes so they can be used in place when loaded):
+ *
+ *   header:  magic 'ECXR', version
+ *   frame:   byte length (excluding this field), tick
+ *            actions:   count, { action id, size, payload }
+ *            adds:      count, { entity, component id, size, payload }
+ *            updates:   count, { entity, component id, size, payload }
+ *            removes:   count, { entity, component id }
+ *            creates:   count, { placeholder, component count,
+ *                                { component id, size, payload } }
+ *            destroys:  count, { entity }
+ */
+class ECSACT_API FEcsactExecutionRecorder {
+	/** actions, adds, updates, removes, creates and destroys */
+	static constexpr int32 SectionCount = 6;
+
+	TUniquePtr<FArchive> Writer;
+	TArray<uint8>        FrameBuffer;
+	int32                LastRecordedTick = INDEX_NONE;
+
+	/**
+	 * Frame for PendingTick. Options recorded for the same tick are merged into
+	 * it and it is written once a later tick is recorded or on Close().
+	 */
+	TArray<uint8> PendingSections[SectionCount];
+	int32         PendingCounts[SectionCount] = {};
+	int32         PendingTick = INDEX_NONE;
+
+	auto BeginFrame(int32 Tick) -> void;
+	auto AppendOptions(const UEcsactUnrealExecutionOptions& Options) -> void;
+	auto FlushFrame() -> void;
+
+public:
+	static constexpr uint32 Magic = 0x52584345; // 'ECXR'
+	static constexpr uint32 Version = 1;
+
+	FEcsactExecutionRecorder();
+	~FEcsactExecutionRecorder();
+
+	auto Open(const FString& Path) -> bool;
+
+	/**
+	 * Records frames to @p Buffer without the stream header. Load them with
+	 * FEcsactExecutionRecording::LoadFrames.
+	 */
+	auto OpenMemory(TArray<uint8>& Buffer) -> void;
+
+	auto Close() -> void;
+	auto IsOpen() const -> bool;
+
+	/**
+	 * Appends one frame. Empty execution options are skipped. Replays execute
+	 * the skipped ticks without options. Options recorded again for the same
+	 * tick (e.g. several enqueues during one async session tick) are merged
+	 * into that tick's frame.
+	 */
+	auto Record(int32 Tick, const UEcsactUnrealExecutionOptions& Options) -> void;
+
+	/**
+	 * Appends an empty frame for tick @p TickCount - 1 unless that tick was
+	 * already recorded so trailing ticks without input are replayed too.
+	 */
+	auto RecordEnd(int32 TickCount) -> void;
+};
+
+/**
+ * A recording loaded by FEcsactExecutionRecording::Load. All frames are
+ * decoded up front into contiguous `ecsact_execution_options` so they can be
+ * passed straight to `ecsact_execute_systems`.
+ */
+class ECSACT_API FEcsactExecutionRecording {
+	TArray<uint8>                        Data;
+	TArray<int32>                        Ticks;
+	TArray<ecsact_execution_options>     Options;
+	TArray<ecsact_action>                Actions;
+	TArray<ecsact_component>             Components;
+	TArray<ecsact_entity_id>             Entities;
+	TArray<ecsact_component_id>          ComponentIds;
+	TArray<ecsact_placeholder_entity_id> Placeholders;
+	TArray<int>                          CreateComponentNums;
+	TArray<ecsact_component*>            CreateComponentLists;
+
+	auto ParseFrames(int32 StartOffset) -> bool;
+
+public:
+	auto Load(const FString& Path) -> bool;
+
+	/**
+	 * Loads frames written by a FEcsactExecutionRecorder opened with
+	 * OpenMemory.
+	 */
+	auto LoadFrames(TArray<uint8> FrameData) -> bool;
+	auto Reset() -> void;
+
+	auto Num() const -> int32 {
+		return Options.Num();
+	}
+
+	auto GetTick(int32 Index) const -> int32 {
+		return Ticks[Index];
+	}
+
+	/**
+	 * Number of ticks from tick 0 through the last recorded frame, including
+	 * ticks that had no input.
+	 */
+	auto GetTickCount() const -> int32 {
+		return Ticks.IsEmpty() ? 0 : Ticks.Last() + 1;
+	}
+
+	auto GetOptions() const -> TConstArrayView<ecsact_execution_options> {
+		return Options;
+	}
+};
@@ -8,8 +8,20 @@
 #include "EcsactUnreal/Ecsact.h"
 #include "EcsactUnreal/RuntimeLoad.h"
 #include "EcsactUnreal/EcsactAsyncRunner.h"
+#include "UObject/UObjectIterator.h"
+
+static FEcsactGameModuleImpl* ActiveGameModule = nullptr;
+
+auto EcsactUnreal::ReloadRuntime() -> bool {
+	if(ActiveGameModule == nullptr) {
+		UE_LOG(Ecsact, Warning, TEXT("No Ecsact game module to reload"));
+		return false;
+	}
+	return ActiveGameModule->ReloadRuntime();
+}
 
 auto FEcsactGameModuleImpl::StartupModule() -> void {
+	ActiveGameModule = this;
 #if WITH_EDITOR
 	FEditorDelegates::PreBeginPIE.AddRaw(
 		this,
@@ -28,6 +40,9 @@ auto FEcsactGameModuleImpl::StartupModule() -> void {
 }
 
 auto FEcsactGameModuleImpl::ShutdownModule() -> void {
+	if(ActiveGameModule == this) {
+		ActiveGameModule = nullptr;
+	}
 	if(RuntimeHandle) {
 		if(ecsact_async_force_reset) {
 			ecsact_async_force_reset();
@@ -42,6 +57,52 @@ auto FEcsactGameModuleImpl::ShutdownModule() -> void {
 	}
 }
 
+auto FEcsactGameModuleImpl::ReloadRuntime() -> bool {
+	if(!RuntimeHandle) {
+		UE_LOG(Ecsact, Warning, TEXT("No Ecsact runtime loaded to reload"));
+		return false;
+	}
+
+	auto runners = TArray<UEcsactRunner*>{};
+	for(auto runner : TObjectRange<UEcsactRunner>()) {
+		if(!runner->IsStopped()) {
+			runners.Add(runner);
+		}
+	}
+
+	for(auto runner : runners) {
+		runner->PreRuntimeReload();
+	}
+
+	if(ecsact_async_force_reset) {
+		ecsact_async_force_reset();
+	}
+	ECSACT_UNLOAD_RUNTIME(RuntimeHandle);
+	RuntimeHandle = ECSACT_LOAD_RUNTIME();
+
+	if(!RuntimeHandle) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("Failed to reload Ecsact runtime - %i runner(s) remain stopped"),
+			runners.Num()
+		);
+		return false;
+	}
+
+	for(auto runner : runners) {
+		runner->PostRuntimeReload();
+	}
+
+	UE_LOG(
+		Ecsact,
+		Log,
+		TEXT("Ecsact runtime reloaded (%i runner(s) restarted)"),
+		runners.Num()
+	);
+	return true;
+}
+
 #if WITH_EDITOR
 auto FEcsactGameModuleImpl::OnPreBeginPIE(bool bIsSimulating) -> void {
 	UE_LOG(Ecsact, Log, TEXT("OnPreBeginPIE"));
@@ -10,6 +10,14 @@
 #	include "Editor.h"
 #endif
 
+namespace EcsactUnreal {
+/**
+ * Hot reloads the Ecsact runtime of the running game module. See
+ * FEcsactGameModuleImpl::ReloadRuntime.
+ */
+ECSACT_API auto ReloadRuntime() -> bool;
+} // namespace EcsactUnreal
+
 class ECSACT_API FEcsactGameModuleImpl : public IModuleInterface {
 	FEcsactRuntimeHandle RuntimeHandle;
 
@@ -31,6 +39,14 @@ public:
 	 */
 	auto ShutdownModule() -> void override;
 
+	/**
+	 * Swaps the loaded ecsact runtime for the one currently on disk without
+	 * restarting. Running runners are stopped (sync runners snapshot their
+	 * registry first), the runtime is unloaded and loaded again and then the
+	 * runners are restarted and restored.
+	 */
+	auto ReloadRuntime() -> bool;
+
 	[[nodiscard]] auto IsGameModule() const -> bool final {
 		return true;
 	}
@@ -0,0 +1,19 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#include "EcsactUnreal/EcsactMemory.h"
+
+LLM_DEFINE_TAG(Ecsact);
+LLM_DEFINE_TAG(Ecsact_ExecutionOptions);
+LLM_DEFINE_TAG(Ecsact_Callbacks);
+LLM_DEFINE_TAG(Ecsact_Recording);
+LLM_DEFINE_TAG(Ecsact_Snapshots);
+LLM_DEFINE_TAG(Ecsact_Subsystems);
+LLM_DEFINE_TAG(Ecsact_Mass);
+
+DEFINE_STAT(STAT_EcsactExecutionOptionsMemory);
+DEFINE_STAT(STAT_EcsactPendingCallbacksMemory);
+DEFINE_STAT(STAT_EcsactPendingCallbacks);
@@ -0,0 +1,54 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Stats/Stats.h"
+
+/**
+ * Low level memory tracker tags for allocations owned by the Ecsact plugin.
+ * Run with `-llm` and use `stat LLMFULL` to view them.
+ */
+LLM_DECLARE_TAG_API(Ecsact, ECSACT_API);
+LLM_DECLARE_TAG_API(Ecsact_ExecutionOptions, ECSACT_API);
+LLM_DECLARE_TAG_API(Ecsact_Callbacks, ECSACT_API);
+LLM_DECLARE_TAG_API(Ecsact_Recording, ECSACT_API);
+LLM_DECLARE_TAG_API(Ecsact_Snapshots, ECSACT_API);
+LLM_DECLARE_TAG_API(Ecsact_Subsystems, ECSACT_API);
+LLM_DECLARE_TAG_API(Ecsact_Mass, ECSACT_API);
+
+/**
+ * `stat EcsactMemory` - totals across every running UEcsactRunner. See
+ * UEcsactRunner::GetExecutionOptionsAllocatedSize for per-runner values.
+ */
+DECLARE_STATS_GROUP(
+	TEXT("EcsactMemory"),
+	STATGROUP_EcsactMemory,
+	STATCAT_Advanced
+);
+
+DECLARE_MEMORY_STAT_EXTERN(
+	TEXT("Execution Options"),
+	STAT_EcsactExecutionOptionsMemory,
+	STATGROUP_EcsactMemory,
+	ECSACT_API
+);
+
+DECLARE_MEMORY_STAT_EXTERN(
+	TEXT("Pending Callbacks"),
+	STAT_EcsactPendingCallbacksMemory,
+	STATGROUP_EcsactMemory,
+	ECSACT_API
+);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Pending Callbacks Count"),
+	STAT_EcsactPendingCallbacks,
+	STATGROUP_EcsactMemory,
+	ECSACT_API
+);
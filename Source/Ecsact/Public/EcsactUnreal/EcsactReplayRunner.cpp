@@ -0,0 +1,94 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#include "EcsactUnreal/EcsactReplayRunner.h"
+#include "EcsactUnreal/Ecsact.h"
+#include "ecsact/runtime/core.h"
+
+UEcsactReplayRunner::UEcsactReplayRunner() : Super() {
+	// Recorded creates were made by a runner that is gone
+	bWarnMissingCreateEntityCallbacks = false;
+}
+
+auto UEcsactReplayRunner::LoadRecording(const FString& Path) -> bool {
+	NextFrame = 0;
+	NextTick = 0;
+	return Recording.Load(Path);
+}
+
+auto UEcsactReplayRunner::ReplayAll() -> int32 {
+	if(ecsact_execute_systems == nullptr) {
+		UE_LOG(Ecsact, Error, TEXT("ecsact_execute_systems is unavailable"));
+		return 0;
+	}
+	if(registry_id == ECSACT_INVALID_ID(registry)) {
+		UE_LOG(Ecsact, Error, TEXT("UEcsactReplayRunner registry_id is unset"));
+		return 0;
+	}
+
+	auto tick_count = Recording.GetTickCount() - NextTick;
+	if(tick_count <= 0) {
+		return 0;
+	}
+
+	// Ticks without inputs were not recorded so spread the frames out
+	auto exec_opts = TArray<ecsact_execution_options>{};
+	exec_opts.SetNumZeroed(tick_count);
+	for(auto i = NextFrame; Recording.Num() > i; ++i) {
+		exec_opts[Recording.GetTick(i) - NextTick] = Recording.GetOptions()[i];
+	}
+
+	auto err = ecsact_execute_systems(
+		registry_id,
+		exec_opts.Num(),
+		exec_opts.GetData(),
+		GetEventsCollector()
+	);
+	if(err != ECSACT_EXEC_SYS_OK) {
+		UE_LOG(Ecsact, Error, TEXT("Ecsact execution failed during replay"));
+	}
+
+	NextFrame = Recording.Num();
+	NextTick = Recording.GetTickCount();
+	return tick_count;
+}
+
+auto UEcsactReplayRunner::Tick(float DeltaTime) -> void {
+	if(ecsact_execute_systems == nullptr ||
+		 registry_id == ECSACT_INVALID_ID(registry) ||
+		 NextTick >= Recording.GetTickCount()) {
+		return;
+	}
+
+	const ecsact_execution_options* exec_opts = nullptr;
+	if(Recording.Num() > NextFrame && Recording.GetTick(NextFrame) == NextTick) {
+		exec_opts = &Recording.GetOptions()[NextFrame];
+		NextFrame += 1;
+	}
+
+	auto err = ecsact_execute_systems( //
+		registry_id,
+		1,
+		exec_opts,
+		GetEventsCollector()
+	);
+	if(err != ECSACT_EXEC_SYS_OK) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("Ecsact execution failed replaying tick %i"),
+			NextTick
+		);
+	}
+	NextTick += 1;
+}
+
+auto UEcsactReplayRunner::GetStatId() const -> TStatId {
+	RETURN_QUICK_DECLARE_CYCLE_STAT( // NOLINT
+		UEcsactReplayRunner,
+		STATGROUP_Tickables
+	);
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EcsactUnreal/EcsactSyncRunner.h"
+#include "EcsactUnreal/EcsactExecutionRecording.h"
+#include "EcsactReplayRunner.generated.h"
+
+/**
+ * Sync runner that feeds a recording made with UEcsactRunner::StartRecording
+ * back into `ecsact_execute_systems`. Events are dispatched to runner
+ * subsystems like any other runner.
+ */
+UCLASS(NotBlueprintable)
+
+class ECSACT_API UEcsactReplayRunner : public UEcsactSyncRunner {
+	GENERATED_BODY() // NOLINT
+
+	FEcsactExecutionRecording Recording;
+	int32                     NextFrame = 0;
+	int32                     NextTick = 0;
+
+public:
+	UEcsactReplayRunner();
+
+	auto LoadRecording(const FString& Path) -> bool;
+
+	auto GetFrameCount() const -> int32 {
+		return Recording.Num();
+	}
+
+	/** Ticks executed by a full replay, including ticks without input. */
+	auto GetTickCount() const -> int32 {
+		return Recording.GetTickCount();
+	}
+
+	/**
+	 * Executes every remaining tick in a single `ecsact_execute_systems` call.
+	 * Returns the number of ticks executed.
+	 */
+	auto ReplayAll() -> int32;
+
+	/**
+	 * Executes one recorded tick per tick. Ticks that had no input when
+	 * recorded are executed without execution options so systems run exactly
+	 * as many times as in the recorded session.
+	 */
+	auto Tick(float DeltaTime) -> void override;
+	auto GetStatId() const -> TStatId override;
+};
@@ -6,6 +6,7 @@
 
 #include "EcsactUnreal/EcsactRunner.h"
 #include "EcsactUnreal/EcsactAsyncRunnerEvents.h"
+#include "EcsactUnreal/EcsactMemory.h"
 #include "EcsactUnreal/EcsactSettings.h"
 #include "EcsactUnreal/EcsactUnrealExecutionOptions.h"
 #include "Engine/Engine.h"
@@ -14,6 +15,7 @@
 #include "UObject/ObjectMacros.h"
 #include "UObject/UObjectIterator.h"
 #include "EcsactUnreal/EcsactRunnerSubsystem.h"
+#include "EcsactUnreal/EcsactEntityRegistrySubsystem.h"
 #include "EcsactUnreal/Ecsact.h"
 #include "ecsact/runtime/common.h"
 
@@ -63,10 +65,12 @@ auto UEcsactRunner::StreamImpl(
 }
 
 auto UEcsactRunner::Start() -> void {
+	LLM_SCOPE_BYTAG(Ecsact);
 	bIsStopped = false;
 
 	RunnerSubsystems.Initialize(this);
 
+	auto entity_registry = GetSubsystem<UEcsactEntityRegistrySubsystem>();
 	for(auto subsystem : GetSubsystemArray<UEcsactRunnerSubsystem>()) {
 		if(subsystem) {
 			UE_LOG(
@@ -76,19 +80,28 @@ auto UEcsactRunner::Start() -> void {
 				*subsystem->GetClass()->GetName()
 			);
 			subsystem->OwningRunner = this;
+			subsystem->EntityRegistry = entity_registry;
 			subsystem->RunnerStart(this);
 		}
 	}
 }
 
 auto UEcsactRunner::Stop() -> void {
+	StopRecording();
+	StopEventRecording();
 	for(auto subsystem : GetSubsystemArray<UEcsactRunnerSubsystem>()) {
 		if(subsystem) {
 			subsystem->RunnerStop(this);
 			subsystem->OwningRunner = nullptr;
+			subsystem->EntityRegistry = nullptr;
 		}
 	}
 	RunnerSubsystems.Deinitialize();
+	CreateEntityCallbacks.Empty();
+	StaleCreateEntityCallbacks.Empty();
+	CreateEntityCallbacksBase = 0;
+	PendingCreateEntityCallbacks = 0;
+	ReportMemoryStats(0, 0, 0);
 	bIsStopped = true;
 }
 
@@ -100,6 +113,14 @@ void UEcsactRunner::OnWorldChanged(UWorld* OldWorld, UWorld* NewWorld) {
 	}
 }
 
+auto UEcsactRunner::PreRuntimeReload() -> void {
+	Stop();
+}
+
+auto UEcsactRunner::PostRuntimeReload() -> void {
+	Start();
+}
+
 auto UEcsactRunner::IsStopped() const -> bool {
 	return bIsStopped;
 }
@@ -108,6 +129,119 @@ auto UEcsactRunner::HasAsyncEvents() const -> bool {
 	return Cast<IEcsactAsyncRunnerEvents>(this) != nullptr;
 }
 
+auto UEcsactRunner::StartRecording(const FString& Path) -> bool {
+	RecorderTick = 0;
+	return Recorder.Open(Path);
+}
+
+auto UEcsactRunner::StopRecording() -> void {
+	Recorder.RecordEnd(RecorderTick);
+	Recorder.Close();
+}
+
+auto UEcsactRunner::IsRecording() const -> bool {
+	return Recorder.IsOpen();
+}
+
+auto UEcsactRunner::StartEventRecording(const FString& Path) -> bool {
+	return EventRecorder.Open(Path);
+}
+
+auto UEcsactRunner::StopEventRecording() -> void {
+	EventRecorder.Close();
+}
+
+auto UEcsactRunner::IsEventRecording() const -> bool {
+	return EventRecorder.IsOpen();
+}
+
+auto UEcsactRunner::SetDispatchingAdditionalRegistry( //
+	bool bDispatching
+) -> void {
+	bDispatchingAdditionalRegistry = bDispatching;
+	EventRecorder.SetPaused(bDispatching);
+}
+
+auto UEcsactRunner::ShouldDispatchTo( //
+	const UEcsactRunnerSubsystem* Subsystem
+) const -> bool {
+	// Entity ids are only unique per registry so subsystems indexing by entity
+	// would mix up entities of different registries
+	return !bDispatchingAdditionalRegistry ||
+		Subsystem->bReceiveAdditionalRegistryEvents;
+}
+
+auto UEcsactRunner::RecordExecutionOptions() -> void {
+	if(!Recorder.IsOpen()) {
+		return;
+	}
+
+	if(ExecutionOptions) {
+		Recorder.Record(RecorderTick, *ExecutionOptions);
+	}
+	RecorderTick += 1;
+}
+
+auto UEcsactRunner::RecordExecutionOptions(int32 Tick) -> void {
+	if(!Recorder.IsOpen()) {
+		return;
+	}
+
+	if(ExecutionOptions) {
+		Recorder.Record(Tick, *ExecutionOptions);
+	}
+	RecorderTick = FMath::Max(RecorderTick, Tick + 1);
+}
+
+auto UEcsactRunner::GetExecutionOptionsAllocatedSize() const -> SIZE_T {
+	if(ExecutionOptions == nullptr) {
+		return 0;
+	}
+	return ExecutionOptions->GetAllocatedSize();
+}
+
+auto UEcsactRunner::GetPendingCallbacksAllocatedSize() const -> SIZE_T {
+	return CreateEntityCallbacks.GetAllocatedSize() +
+		StaleCreateEntityCallbacks.GetAllocatedSize();
+}
+
+auto UEcsactRunner::GetPendingCallbacksNum() const -> int32 {
+	return PendingCreateEntityCallbacks;
+}
+
+auto UEcsactRunner::UpdateMemoryStats() -> void {
+#if STATS
+	ReportMemoryStats(
+		static_cast<int64>(GetExecutionOptionsAllocatedSize()),
+		static_cast<int64>(GetPendingCallbacksAllocatedSize()),
+		GetPendingCallbacksNum()
+	);
+#endif
+}
+
+auto UEcsactRunner::ReportMemoryStats(
+	int64 ExecutionOptionsBytes,
+	int64 PendingCallbacksBytes,
+	int32 PendingCallbacks
+) -> void {
+	// Stats are totals across runners so only our difference is applied
+	INC_MEMORY_STAT_BY(
+		STAT_EcsactExecutionOptionsMemory,
+		ExecutionOptionsBytes - ReportedExecutionOptionsBytes
+	);
+	INC_MEMORY_STAT_BY(
+		STAT_EcsactPendingCallbacksMemory,
+		PendingCallbacksBytes - ReportedPendingCallbacksBytes
+	);
+	INC_DWORD_STAT_BY(
+		STAT_EcsactPendingCallbacks,
+		PendingCallbacks - ReportedPendingCallbacks
+	);
+	ReportedExecutionOptionsBytes = ExecutionOptionsBytes;
+	ReportedPendingCallbacksBytes = PendingCallbacksBytes;
+	ReportedPendingCallbacks = PendingCallbacks;
+}
+
 auto UEcsactRunner::Tick(float DeltaTime) -> void {
 }
 
@@ -131,13 +265,92 @@ auto UEcsactRunner::DestroyEntity(ecsact_entity_id Entity) -> void {
 }
 
 auto UEcsactRunner::GeneratePlaceholderId() -> ecsact_placeholder_entity_id {
-	static ecsact_placeholder_entity_id LastPlaceholderId = {};
 	using ref_t = std::add_lvalue_reference_t<
 		std::underlying_type_t<decltype(LastPlaceholderId)>>;
 	reinterpret_cast<ref_t>(LastPlaceholderId) += 1;
 	return LastPlaceholderId;
 }
 
+auto UEcsactRunner::AddCreateEntityCallback(
+	ecsact_placeholder_entity_id      PlaceholderId,
+	TDelegate<void(ecsact_entity_id)> Callback
+) -> void {
+	LLM_SCOPE_BYTAG(Ecsact_Callbacks);
+	auto placeholder = static_cast<int32>(PlaceholderId);
+	MoveStaleCreateEntityCallbacks();
+	if(CreateEntityCallbacks.IsEmpty()) {
+		CreateEntityCallbacks.Reset();
+		CreateEntityCallbacksBase = placeholder;
+	} else if(placeholder < CreateEntityCallbacksBase) {
+		// Builders may call OnCreate out of placeholder order
+		CreateEntityCallbacks.InsertDefaulted(
+			0,
+			CreateEntityCallbacksBase - placeholder
+		);
+		CreateEntityCallbacksBase = placeholder;
+	}
+
+	auto index = placeholder - CreateEntityCallbacksBase;
+	if(CreateEntityCallbacks.Num() <= index) {
+		CreateEntityCallbacks.SetNum(index + 1);
+	}
+
+	if(!CreateEntityCallbacks[index].IsBound()) {
+		PendingCreateEntityCallbacks += 1;
+	}
+	CreateEntityCallbacks[index] = MoveTemp(Callback);
+}
+
+auto UEcsactRunner::TakeCreateEntityCallback( //
+	ecsact_placeholder_entity_id PlaceholderId
+) -> TDelegate<void(ecsact_entity_id)> {
+	auto placeholder = static_cast<int32>(PlaceholderId);
+	auto callback = TDelegate<void(ecsact_entity_id)>{};
+	auto index = placeholder - CreateEntityCallbacksBase;
+	if(CreateEntityCallbacks.IsValidIndex(index)) {
+		callback = MoveTemp(CreateEntityCallbacks[index]);
+		CreateEntityCallbacks[index].Unbind();
+
+		// Trim taken slots so the base follows the oldest pending create
+		auto taken_count = 0;
+		while(CreateEntityCallbacks.Num() > taken_count &&
+					!CreateEntityCallbacks[taken_count].IsBound()) {
+			taken_count += 1;
+		}
+		if(taken_count > 0) {
+			CreateEntityCallbacks.RemoveAt(0, taken_count, EAllowShrinking::No);
+			CreateEntityCallbacksBase += taken_count;
+		}
+	} else {
+		StaleCreateEntityCallbacks.RemoveAndCopyValue(placeholder, callback);
+	}
+
+	if(callback.IsBound()) {
+		PendingCreateEntityCallbacks -= 1;
+	}
+	return callback;
+}
+
+auto UEcsactRunner::MoveStaleCreateEntityCallbacks() -> void {
+	// Only happens when creates at the front never complete. Moving them out
+	// keeps the array proportional to the number of pending creates.
+	constexpr auto min_stale_span = 64;
+	auto span = CreateEntityCallbacks.Num();
+	if(span < min_stale_span || span <= PendingCreateEntityCallbacks * 2) {
+		return;
+	}
+
+	for(auto i = 0; span > i; ++i) {
+		if(CreateEntityCallbacks[i].IsBound()) {
+			StaleCreateEntityCallbacks.Add(
+				CreateEntityCallbacksBase + i,
+				MoveTemp(CreateEntityCallbacks[i])
+			);
+		}
+	}
+	CreateEntityCallbacks.Reset();
+}
+
 auto UEcsactRunner::GetEventsCollector() -> ecsact_execution_events_collector* {
 	return &EventsCollector;
 }
@@ -150,7 +363,16 @@ auto UEcsactRunner::OnInitComponentRaw(
 	void*               callback_user_data
 ) -> void {
 	auto self = static_cast<ThisClass*>(callback_user_data);
+	self->EventRecorder.RecordComponent(
+		event,
+		entity_id,
+		component_id,
+		component_data
+	);
 	for(auto s : GetRunnerSubsystemsWarn(self, TEXT("InitComponent"))) {
+		if(!self->ShouldDispatchTo(s)) {
+			continue;
+		}
 		s->InitComponentRaw(entity_id, component_id, component_data);
 	}
 }
@@ -163,7 +385,16 @@ auto UEcsactRunner::OnUpdateComponentRaw(
 	void*               callback_user_data
 ) -> void {
 	auto self = static_cast<ThisClass*>(callback_user_data);
+	self->EventRecorder.RecordComponent(
+		event,
+		entity_id,
+		component_id,
+		component_data
+	);
 	for(auto s : GetRunnerSubsystemsWarn(self, TEXT("UpdateComponent"))) {
+		if(!self->ShouldDispatchTo(s)) {
+			continue;
+		}
 		s->UpdateComponentRaw(entity_id, component_id, component_data);
 	}
 }
@@ -176,7 +407,16 @@ auto UEcsactRunner::OnRemoveComponentRaw(
 	void*               callback_user_data
 ) -> void {
 	auto self = static_cast<ThisClass*>(callback_user_data);
+	self->EventRecorder.RecordComponent(
+		event,
+		entity_id,
+		component_id,
+		component_data
+	);
 	for(auto s : GetRunnerSubsystemsWarn(self, TEXT("RemoveComponent"))) {
+		if(!self->ShouldDispatchTo(s)) {
+			continue;
+		}
 		s->RemoveComponentRaw(entity_id, component_id, component_data);
 	}
 }
@@ -188,13 +428,13 @@ auto UEcsactRunner::OnEntityCreatedRaw(
 	void*                        callback_user_data
 ) -> void {
 	auto self = static_cast<ThisClass*>(callback_user_data);
+	self->EventRecorder.RecordEntity(event, entity_id, placeholder_entity_id);
 
-	auto create_callback =
-		self->CreateEntityCallbacks.Find(placeholder_entity_id);
-	if(create_callback) {
-		create_callback->Execute(entity_id);
-		self->CreateEntityCallbacks.Remove(placeholder_entity_id);
-	} else if((int32)placeholder_entity_id > 0) {
+	auto create_callback = self->TakeCreateEntityCallback(placeholder_entity_id);
+	if(create_callback.IsBound()) {
+		create_callback.Execute(entity_id);
+	} else if(self->bWarnMissingCreateEntityCallbacks &&
+						(int32)placeholder_entity_id > 0) {
 		UE_LOG(
 			Ecsact,
 			Error,
@@ -204,6 +444,9 @@ auto UEcsactRunner::OnEntityCreatedRaw(
 	}
 
 	for(auto s : GetRunnerSubsystemsWarn(self, TEXT("EntityCreated"))) {
+		if(!self->ShouldDispatchTo(s)) {
+			continue;
+		}
 		s->EntityCreated(static_cast<int32>(entity_id));
 	}
 }
@@ -215,9 +458,19 @@ auto UEcsactRunner::OnEntityDestroyedRaw(
 	void*                        callback_user_data
 ) -> void {
 	auto self = static_cast<ThisClass*>(callback_user_data);
+	self->EventRecorder.RecordEntity(event, entity_id, placeholder_entity_id);
 	for(auto s : GetRunnerSubsystemsWarn(self, TEXT("EntityDestroyed"))) {
+		if(!self->ShouldDispatchTo(s)) {
+			continue;
+		}
 		s->EntityDestroyed(static_cast<int32>(entity_id));
 	}
+
+	// Unbound last so every subsystem can still find the entity's object
+	auto entity_registry = self->GetSubsystem<UEcsactEntityRegistrySubsystem>();
+	if(entity_registry && self->ShouldDispatchTo(entity_registry)) {
+		entity_registry->Unbind(static_cast<int32>(entity_id));
+	}
 }
 
 UEcsactRunner::EcsactRunnerCreateEntityBuilder::EcsactRunnerCreateEntityBuilder(
@@ -239,9 +492,22 @@ auto UEcsactRunner::EcsactRunnerCreateEntityBuilder::Finish() -> void {
 	Builder.Finish();
 }
 
+auto UEcsactRunner::EcsactRunnerCreateEntityBuilder::AddComponentRaw(
+	ecsact_component_id ComponentId,
+	const void*         ComponentData,
+	int32               ComponentSize
+) && -> EcsactRunnerCreateEntityBuilder {
+	Builder = std::move(Builder).AddComponentRaw(
+		ComponentId,
+		ComponentData,
+		ComponentSize
+	);
+	return std::move(*this);
+}
+
 auto UEcsactRunner::EcsactRunnerCreateEntityBuilder::OnCreate(
 	TDelegate<void(ecsact_entity_id)> Callback
 ) && -> EcsactRunnerCreateEntityBuilder {
-	Owner->CreateEntityCallbacks.Add(PlaceholderId, Callback);
+	Owner->AddCreateEntityCallback(PlaceholderId, MoveTemp(Callback));
 	return std::move(*this);
 }
@@ -9,6 +9,8 @@
 #include "CoreMinimal.h"
 #include "Tickable.h"
 #include "EcsactUnreal/EcsactUnrealExecutionOptions.h"
+#include "EcsactUnreal/EcsactExecutionRecording.h"
+#include "EcsactUnreal/EcsactEventRecording.h"
 #include "EcsactUnreal/EcsactRunnerSubsystem.h"
 #include "Subsystems/SubsystemCollection.h"
 #include "ecsact/runtime/common.h"
@@ -28,8 +30,51 @@ class ECSACT_API UEcsactRunner : public UObject, public FTickableGameObject {
 
 	FSubsystemCollection<class UEcsactRunnerSubsystem> RunnerSubsystems;
 
-	TMap<ecsact_placeholder_entity_id, TDelegate<void(ecsact_entity_id)>>
-		CreateEntityCallbacks;
+	ecsact_placeholder_entity_id LastPlaceholderId = {};
+
+	FEcsactExecutionRecorder Recorder;
+	int32                    RecorderTick = 0;
+	FEcsactEventRecorder     EventRecorder;
+
+	bool bDispatchingAdditionalRegistry = false;
+
+	auto ShouldDispatchTo(const class UEcsactRunnerSubsystem* Subsystem) const
+		-> bool;
+
+	/**
+	 * Create entity callbacks indexed by placeholder id minus
+	 * CreateEntityCallbacksBase. Taken slots at the front are trimmed so the
+	 * base follows the oldest in-flight create. If old creates never complete
+	 * their callbacks are moved to StaleCreateEntityCallbacks instead of
+	 * keeping the array range open.
+	 */
+	TArray<TDelegate<void(ecsact_entity_id)>> CreateEntityCallbacks;
+	int32                                     CreateEntityCallbacksBase = 0;
+	int32                                     PendingCreateEntityCallbacks = 0;
+
+	TMap<int32, TDelegate<void(ecsact_entity_id)>> StaleCreateEntityCallbacks;
+
+	auto MoveStaleCreateEntityCallbacks() -> void;
+
+	/** Values last added to the `stat EcsactMemory` totals by this runner. */
+	int64 ReportedExecutionOptionsBytes = 0;
+	int64 ReportedPendingCallbacksBytes = 0;
+	int32 ReportedPendingCallbacks = 0;
+
+	auto ReportMemoryStats(
+		int64 ExecutionOptionsBytes,
+		int64 PendingCallbacksBytes,
+		int32 PendingCallbacks
+	) -> void;
+
+	auto AddCreateEntityCallback(
+		ecsact_placeholder_entity_id      PlaceholderId,
+		TDelegate<void(ecsact_entity_id)> Callback
+	) -> void;
+
+	auto TakeCreateEntityCallback( //
+		ecsact_placeholder_entity_id PlaceholderId
+	) -> TDelegate<void(ecsact_entity_id)>;
 
 	static auto OnInitComponentRaw(
 		ecsact_event        event,
@@ -76,6 +121,38 @@ protected:
 	auto GetEventsCollector() -> ecsact_execution_events_collector*;
 	auto GetRunnerSubsystems() -> TArray<class UEcsactRunnerSubsystem*>;
 
+	/**
+	 * Writes the pending execution options to the active recording (if any.)
+	 * Runners call this once per tick right before submitting them.
+	 */
+	auto RecordExecutionOptions() -> void;
+
+	/**
+	 * Writes the pending execution options to the active recording (if any)
+	 * for @p Tick. For runners that don't own the tick (e.g. async sessions.)
+	 */
+	auto RecordExecutionOptions(int32 Tick) -> void;
+
+	/**
+	 * Logs an error when a created entity's placeholder has no OnCreate
+	 * callback. Runners that execute recorded creates turn this off.
+	 */
+	bool bWarnMissingCreateEntityCallbacks = true;
+
+	/**
+	 * Updates this runner's share of `stat EcsactMemory`. Runners call this once
+	 * per tick while the execution options are at their largest.
+	 */
+	auto UpdateMemoryStats() -> void;
+
+	/**
+	 * Marks events dispatched until this is called again with false as coming
+	 * from a registry other than the runner's own. They only reach subsystems
+	 * with bReceiveAdditionalRegistryEvents and are kept out of the event
+	 * recording (if any.)
+	 */
+	auto SetDispatchingAdditionalRegistry(bool bDispatching) -> void;
+
 protected:
 	virtual auto GeneratePlaceholderId() -> ecsact_placeholder_entity_id;
 	virtual auto StreamImpl(
@@ -95,9 +172,52 @@ public:
 
 	virtual auto OnWorldChanged(UWorld* OldWorld, UWorld* NewWorld) -> void;
 
+	/**
+	 * Called by FEcsactGameModuleImpl::ReloadRuntime before the ecsact runtime
+	 * is unloaded. Stops the runner by default.
+	 */
+	virtual auto PreRuntimeReload() -> void;
+
+	/**
+	 * Called once the new ecsact runtime is loaded. Starts the runner by
+	 * default.
+	 */
+	virtual auto PostRuntimeReload() -> void;
+
 	UFUNCTION(BlueprintPure, Category = "Ecsact Runner")
 	bool HasAsyncEvents() const;
 
+	/**
+	 * Record every submitted execution options to @p Path. See
+	 * FEcsactExecutionRecorder for the format and UEcsactReplayRunner to play
+	 * it back. Replays start from an empty registry so runners refuse to start
+	 * recording once entities may exist.
+	 */
+	virtual auto StartRecording(const FString& Path) -> bool;
+	auto StopRecording() -> void;
+	auto IsRecording() const -> bool;
+
+	/**
+	 * Record every event this runner receives to @p Path. See
+	 * FEcsactEventRecorder for the format and UEcsactEventPlaybackRunner to play
+	 * it back.
+	 */
+	auto StartEventRecording(const FString& Path) -> bool;
+	auto StopEventRecording() -> void;
+	auto IsEventRecording() const -> bool;
+
+	/**
+	 * Bytes held by the execution options waiting to be submitted.
+	 */
+	auto GetExecutionOptionsAllocatedSize() const -> SIZE_T;
+
+	/**
+	 * Bytes held by callbacks waiting on the Ecsact runtime (e.g. create entity
+	 * callbacks.)
+	 */
+	virtual auto GetPendingCallbacksAllocatedSize() const -> SIZE_T;
+	virtual auto GetPendingCallbacksNum() const -> int32;
+
 	auto Tick(float DeltaTime) -> void override;
 	auto GetStatId() const -> TStatId override;
 	auto IsTickable() const -> bool override;
@@ -154,6 +274,14 @@ public:
 		return ExecutionOptions->PushAction<A>(Action);
 	}
 
+	auto PushActionRaw(
+		ecsact_action_id ActionId,
+		const void*      ActionData,
+		int32            ActionSize
+	) -> void {
+		return ExecutionOptions->PushActionRaw(ActionId, ActionData, ActionSize);
+	}
+
 	template<typename C>
 	auto AddComponent(ecsact_entity_id Entity, const C& Component) -> void {
 		return ExecutionOptions->AddComponent<C>(Entity, Component);
@@ -164,6 +292,20 @@ public:
 		return ExecutionOptions->UpdateComponent<C>(Entity, Component);
 	}
 
+	auto UpdateComponentRaw(
+		ecsact_entity_id    Entity,
+		ecsact_component_id ComponentId,
+		const void*         ComponentData,
+		int32               ComponentSize
+	) -> void {
+		return ExecutionOptions->UpdateComponentRaw(
+			Entity,
+			ComponentId,
+			ComponentData,
+			ComponentSize
+		);
+	}
+
 	template<typename C>
 	auto RemoveComponent(ecsact_entity_id Entity) -> void {
 		return ExecutionOptions->RemoveComponent<C>(Entity);
@@ -197,6 +339,12 @@ public:
 		return std::move(*this);
 	}
 
+	auto AddComponentRaw(
+		ecsact_component_id ComponentId,
+		const void*         ComponentData,
+		int32               ComponentSize
+	) && -> EcsactRunnerCreateEntityBuilder;
+
 	/**
 	 * Listens for when the entity is created.
 	 */
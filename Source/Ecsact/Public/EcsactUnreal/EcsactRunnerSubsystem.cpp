@@ -6,6 +6,7 @@
 
 #include "EcsactRunnerSubsystem.h"
 #include "EcsactRunner.h"
+#include "EcsactEntityRegistrySubsystem.h"
 
 auto UEcsactRunnerSubsystem::InitComponentRaw(
 	ecsact_entity_id    EntityId,
@@ -36,6 +37,18 @@ auto UEcsactRunnerSubsystem::GetRunner() const -> const class UEcsactRunner* {
 	return OwningRunner;
 }
 
+auto UEcsactRunnerSubsystem::GetEntityRegistry() const
+	-> class UEcsactEntityRegistrySubsystem* {
+	return EntityRegistry;
+}
+
+auto UEcsactRunnerSubsystem::FindBoundObject(int32 Entity) const -> UObject* {
+	if(EntityRegistry == nullptr) {
+		return nullptr;
+	}
+	return EntityRegistry->GetBoundObject(Entity);
+}
+
 auto UEcsactRunnerSubsystem::GetWorld() const -> class UWorld* {
 	if(OwningRunner != nullptr) {
 		return OwningRunner->GetWorld();
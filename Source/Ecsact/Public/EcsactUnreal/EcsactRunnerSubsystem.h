@@ -17,7 +17,8 @@ class ECSACT_API UEcsactRunnerSubsystem : public USubsystem {
 	GENERATED_BODY() // NOLINT
 
 	friend class UEcsactRunner;
-	class UEcsactRunner* OwningRunner;
+	class UEcsactRunner*                  OwningRunner;
+	class UEcsactEntityRegistrySubsystem* EntityRegistry = nullptr;
 
 protected:
 	virtual void InitComponentRaw(
@@ -39,6 +40,22 @@ protected:
 	auto GetRunner() -> class UEcsactRunner*;
 	auto GetRunner() const -> const class UEcsactRunner*;
 
+	auto GetEntityRegistry() const -> class UEcsactEntityRegistrySubsystem*;
+
+	/**
+	 * Object bound to @p Entity in the runner's entity registry. This is a
+	 * single array index so it may be used to route every component event.
+	 */
+	auto FindBoundObject(int32 Entity) const -> UObject*;
+
+	/**
+	 * Also receive events from registries added with
+	 * UEcsactSyncRunner::AddRegistry. Entity ids are only unique per registry
+	 * so use UEcsactSyncRunner::GetEventRegistry to tell them apart.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Ecsact Runner")
+	bool bReceiveAdditionalRegistryEvents = false;
+
 public:
 	auto GetWorld() const -> class UWorld* override;
 
@@ -40,6 +40,21 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Build")
 	bool bEnableBuild = false;
 
+	/**
+	 * Reload the Ecsact runtime into a running PIE session after a successful
+	 * build. Sync runners keep their registry state across the reload.
+	 */
+	UPROPERTY(
+		EditAnywhere,
+		Config,
+		Category = "Build",
+		Meta = ( //
+			EditCondition = "bEnableBuild",
+			EditConditionHides
+		)
+	)
+	bool bHotReloadRuntime = true;
+
 #endif
 
 	/**
@@ -105,6 +120,25 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Runtime")
 	bool bAutoCollectBlueprintRunnerSubsystems = true;
 
+	/**
+	 * Load the Ecsact runtime library on a background thread while the engine
+	 * boots so ECSACT_LOAD_RUNTIME() only has to resolve symbols. Ignored in
+	 * the editor where the runtime may be rebuilt before play.
+	 *
+	 * Off by default. The load runs alongside the engine's own module loading
+	 * so only enable it if the runtime library has no dependencies that rely on
+	 * the engine's DLL search directories.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime")
+	bool bPreloadRuntimeLibrary = false;
+
+	/**
+	 * Enables the generated component mirror runner subsystems. Each package
+	 * mirror keeps a local copy of every component for O(1) lookups.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime")
+	bool bEnableComponentMirrors = false;
+
 	UPROPERTY(
 		EditAnywhere,
 		Config,
@@ -8,12 +8,157 @@
 #include "EcsactUnreal/Ecsact.h"
 #include "EcsactUnreal/EcsactUnrealExecutionOptions.h"
 #include "EcsactUnreal/EcsactExecution.h"
+#include "EcsactUnreal/EcsactMemory.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Compression.h"
 #include "ecsact/runtime/core.h"
+#include "ecsact/runtime/serialize.h"
 #include "ecsact/si/wasm.h"
 
+namespace {
+struct FSnapshotHeader {
+	uint32 Magic;
+	uint32 Version;
+	uint32 bCompressed;
+	int32  UncompressedSize;
+};
+
+constexpr uint32 SnapshotMagic = 0x53534345; // 'ECSS'
+constexpr uint32 SnapshotVersion = 1;
+
+using FComponentState = TMap<ecsact_component_id, TArray<uint8>>;
+using FRegistryState = TMap<ecsact_entity_id, FComponentState>;
+
+auto CaptureRegistryState(ecsact_registry_id Registry) -> FRegistryState {
+	auto entities = TArray<ecsact_entity_id>{};
+	entities.SetNumUninitialized(ecsact_count_entities(Registry));
+	auto entities_count = int32_t{};
+	ecsact_get_entities(
+		Registry,
+		entities.Num(),
+		entities.GetData(),
+		&entities_count
+	);
+	entities.SetNum(entities_count);
+
+	auto state = FRegistryState{};
+	state.Reserve(entities.Num());
+	for(auto entity : entities) {
+		ecsact_each_component(
+			Registry,
+			entity,
+			[](
+				ecsact_component_id component_id,
+				const void*         component_data,
+				void*               user_data
+			) {
+				auto size = ecsact_serialize_component_size(component_id);
+				static_cast<FComponentState*>(user_data)->Add(
+					component_id,
+					TArray<uint8>(static_cast<const uint8*>(component_data), size)
+				);
+			},
+			&state.Add(entity)
+		);
+	}
+	return state;
+}
+
+/**
+ * Dispatches the events that would turn @p Before into @p After.
+ */
+auto DispatchStateDiff(
+	const FRegistryState&                    Before,
+	const FRegistryState&                    After,
+	const ecsact_execution_events_collector* EventsCollector
+) -> void {
+	auto remove = [&](ecsact_entity_id entity, const auto& component) {
+		EventsCollector->remove_callback(
+			ECSACT_EVENT_REMOVE_COMPONENT,
+			entity,
+			component.Key,
+			component.Value.GetData(),
+			EventsCollector->remove_callback_user_data
+		);
+	};
+
+	for(const auto& entry : Before) {
+		if(After.Contains(entry.Key)) {
+			continue;
+		}
+		for(const auto& component : entry.Value) {
+			remove(entry.Key, component);
+		}
+		EventsCollector->entity_destroyed_callback(
+			ECSACT_EVENT_DESTROYED_ENTITY,
+			entry.Key,
+			ECSACT_INVALID_ID(placeholder_entity),
+			EventsCollector->entity_destroyed_callback_user_data
+		);
+	}
+
+	for(const auto& entry : After) {
+		auto before_components = Before.Find(entry.Key);
+		if(before_components == nullptr) {
+			EventsCollector->entity_created_callback(
+				ECSACT_EVENT_CREATED_ENTITY,
+				entry.Key,
+				ECSACT_INVALID_ID(placeholder_entity),
+				EventsCollector->entity_created_callback_user_data
+			);
+		} else {
+			for(const auto& component : *before_components) {
+				if(!entry.Value.Contains(component.Key)) {
+					remove(entry.Key, component);
+				}
+			}
+		}
+
+		for(const auto& component : entry.Value) {
+			auto before_data = before_components //
+				? before_components->Find(component.Key)
+				: nullptr;
+			if(before_data == nullptr) {
+				EventsCollector->init_callback(
+					ECSACT_EVENT_INIT_COMPONENT,
+					entry.Key,
+					component.Key,
+					component.Value.GetData(),
+					EventsCollector->init_callback_user_data
+				);
+			} else if(*before_data != component.Value) {
+				EventsCollector->update_callback(
+					ECSACT_EVENT_UPDATE_COMPONENT,
+					entry.Key,
+					component.Key,
+					component.Value.GetData(),
+					EventsCollector->update_callback_user_data
+				);
+			}
+		}
+	}
+}
+} // namespace
+
 UEcsactSyncRunner::UEcsactSyncRunner() : Super() {
 }
 
+auto UEcsactSyncRunner::StartRecording(const FString& Path) -> bool {
+	if(registry_id != ECSACT_INVALID_ID(registry) && ecsact_count_entities &&
+		 ecsact_count_entities(registry_id) > 0) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("Cannot record %s - recordings replay from an empty registry and "
+					 "registry_id already has entities"),
+			*Path
+		);
+		return false;
+	}
+
+	return Super::StartRecording(Path);
+}
+
 auto UEcsactSyncRunner::StreamImpl(
 	ecsact_entity_id    Entity,
 	ecsact_component_id ComponentId,
@@ -27,6 +172,440 @@ auto UEcsactSyncRunner::StreamImpl(
 	ecsact_stream(registry_id, Entity, ComponentId, ComponentData, nullptr);
 }
 
+auto UEcsactSyncRunner::AddRegistry(const FString& Name) -> ecsact_registry_id {
+	if(ecsact_create_registry == nullptr) {
+		UE_LOG(Ecsact, Error, TEXT("ecsact_create_registry is unavailable"));
+		return ECSACT_INVALID_ID(registry);
+	}
+
+	auto& registry = AdditionalRegistries.Emplace_GetRef(
+		MakeUnique<FEcsactSyncRunnerRegistry>()
+	);
+	if(!registry->Recorder.OpenMemory(registry->Events)) {
+		AdditionalRegistries.Pop();
+		return ECSACT_INVALID_ID(registry);
+	}
+
+	registry->Id = ecsact_create_registry(TCHAR_TO_UTF8(*Name));
+	registry->EventsCollector = registry->Recorder.MakeEventsCollector();
+	registry->LastError = ECSACT_EXEC_SYS_OK;
+	AdditionalExecutionOptions.Add( //
+		NewObject<UEcsactUnrealExecutionOptions>(this)
+	);
+	return registry->Id;
+}
+
+auto UEcsactSyncRunner::RemoveRegistry(ecsact_registry_id Registry) -> void {
+	auto index = AdditionalRegistries.IndexOfByPredicate([&](const auto& entry) {
+		return entry->Id == Registry;
+	});
+	if(index == INDEX_NONE) {
+		UE_LOG(
+			Ecsact,
+			Warning,
+			TEXT("RemoveRegistry: registry %i was not added to this runner"),
+			static_cast<int32>(Registry)
+		);
+		return;
+	}
+
+	if(ecsact_destroy_registry) {
+		ecsact_destroy_registry(Registry);
+	}
+	AdditionalExecutionOptions[index]->Clear();
+	AdditionalRegistries.RemoveAt(index);
+	AdditionalExecutionOptions.RemoveAt(index);
+}
+
+auto UEcsactSyncRunner::GetRegistryExecutionOptions( //
+	ecsact_registry_id Registry
+) -> UEcsactUnrealExecutionOptions* {
+	auto index = AdditionalRegistries.IndexOfByPredicate([&](const auto& entry) {
+		return entry->Id == Registry;
+	});
+	if(index == INDEX_NONE) {
+		return nullptr;
+	}
+	return AdditionalExecutionOptions[index];
+}
+
+auto UEcsactSyncRunner::ExecuteAdditionalRegistries() -> void {
+	if(AdditionalRegistries.IsEmpty()) {
+		return;
+	}
+
+	for(auto& registry : AdditionalRegistries) {
+		registry->Events.Reset();
+		registry->Recorder.OpenMemory(registry->Events);
+	}
+
+	ParallelFor(AdditionalRegistries.Num(), [this](int32 Index) {
+		auto& registry = *AdditionalRegistries[Index];
+		auto  exec_opts = AdditionalExecutionOptions[Index];
+		registry.LastError = ecsact_execute_systems(
+			registry.Id,
+			1,
+			exec_opts->IsNotEmpty() ? exec_opts->GetCPtr() : nullptr,
+			&registry.EventsCollector
+		);
+	});
+
+	for(auto i = 0; AdditionalRegistries.Num() > i; ++i) {
+		auto& registry = *AdditionalRegistries[i];
+		AdditionalExecutionOptions[i]->Clear();
+
+		if(registry.LastError != ECSACT_EXEC_SYS_OK) {
+			UE_LOG(
+				Ecsact,
+				Error,
+				TEXT("Ecsact execution failed for registry %i"),
+				static_cast<int32>(registry.Id)
+			);
+		}
+
+		// Creates pushed through GetRegistryExecutionOptions are still pending
+		// so their placeholders are passed through
+		auto offset = int64{};
+		EventRegistry = registry.Id;
+		SetDispatchingAdditionalRegistry(true);
+		EcsactUnreal::DispatchRecordedEvents(
+			registry.Events.GetData(),
+			registry.Events.Num(),
+			offset,
+			TNumericLimits<double>::Max(),
+			GetEventsCollector(),
+			true
+		);
+		SetDispatchingAdditionalRegistry(false);
+	}
+
+	EventRegistry = registry_id;
+}
+
+auto UEcsactSyncRunner::SaveSnapshot(
+	TArray<uint8>& OutSnapshot,
+	bool           bCompress
+) -> bool {
+	if(ecsact_dump_entities == nullptr) {
+		UE_LOG(Ecsact, Error, TEXT("ecsact_dump_entities is unavailable"));
+		return false;
+	}
+	if(registry_id == ECSACT_INVALID_ID(registry)) {
+		UE_LOG(Ecsact, Error, TEXT("UEcsactSyncRunner registry_id is unset"));
+		return false;
+	}
+
+	LLM_SCOPE_BYTAG(Ecsact_Snapshots);
+	auto dump = TArray<uint8>{};
+	ecsact_dump_entities(
+		registry_id,
+		[](const void* data, int32_t data_length, void* user_data) {
+			static_cast<TArray<uint8>*>(user_data)->Append(
+				static_cast<const uint8*>(data),
+				data_length
+			);
+		},
+		&dump
+	);
+
+	auto header = FSnapshotHeader{
+		.Magic = SnapshotMagic,
+		.Version = SnapshotVersion,
+		.bCompressed = 0,
+		.UncompressedSize = dump.Num(),
+	};
+
+	OutSnapshot.Reset();
+	OutSnapshot.AddUninitialized(sizeof(FSnapshotHeader));
+
+	if(bCompress) {
+		auto compressed_size =
+			FCompression::CompressMemoryBound(NAME_Zlib, dump.Num());
+		OutSnapshot.AddUninitialized(compressed_size);
+		auto compressed = FCompression::CompressMemory(
+			NAME_Zlib,
+			OutSnapshot.GetData() + sizeof(FSnapshotHeader),
+			compressed_size,
+			dump.GetData(),
+			dump.Num()
+		);
+		if(compressed) {
+			header.bCompressed = 1;
+			OutSnapshot.SetNum(
+				sizeof(FSnapshotHeader) + compressed_size,
+				EAllowShrinking::No
+			);
+		} else {
+			OutSnapshot.SetNum(sizeof(FSnapshotHeader), EAllowShrinking::No);
+		}
+	}
+
+	if(!header.bCompressed) {
+		OutSnapshot.Append(dump);
+	}
+
+	FMemory::Memcpy(OutSnapshot.GetData(), &header, sizeof(FSnapshotHeader));
+	return true;
+}
+
+auto UEcsactSyncRunner::LoadSnapshot(TConstArrayView<uint8> Snapshot) -> bool {
+	return RestoreSnapshot(Snapshot, GetEventsCollector());
+}
+
+auto UEcsactSyncRunner::RestoreSnapshot(
+	TConstArrayView<uint8>                   Snapshot,
+	const ecsact_execution_events_collector* EventsCollector
+) -> bool {
+	if(ecsact_restore_entities == nullptr) {
+		UE_LOG(Ecsact, Error, TEXT("ecsact_restore_entities is unavailable"));
+		return false;
+	}
+	if(registry_id == ECSACT_INVALID_ID(registry)) {
+		UE_LOG(Ecsact, Error, TEXT("UEcsactSyncRunner registry_id is unset"));
+		return false;
+	}
+
+	auto header = FSnapshotHeader{};
+	if(Snapshot.Num() < static_cast<int32>(sizeof(FSnapshotHeader))) {
+		UE_LOG(Ecsact, Error, TEXT("Invalid Ecsact snapshot"));
+		return false;
+	}
+	FMemory::Memcpy(&header, Snapshot.GetData(), sizeof(FSnapshotHeader));
+	if(header.Magic != SnapshotMagic || header.Version != SnapshotVersion ||
+		 header.UncompressedSize < 0) {
+		UE_LOG(Ecsact, Error, TEXT("Invalid Ecsact snapshot"));
+		return false;
+	}
+
+	auto payload = Snapshot.RightChop(sizeof(FSnapshotHeader));
+	auto uncompressed = TArray<uint8>{};
+	if(header.bCompressed) {
+		uncompressed.SetNumUninitialized(header.UncompressedSize);
+		auto decompressed = FCompression::UncompressMemory(
+			NAME_Zlib,
+			uncompressed.GetData(),
+			uncompressed.Num(),
+			payload.GetData(),
+			payload.Num()
+		);
+		if(!decompressed) {
+			UE_LOG(Ecsact, Error, TEXT("Failed to decompress Ecsact snapshot"));
+			return false;
+		}
+		payload = uncompressed;
+	}
+
+	struct FRestoreReader {
+		TConstArrayView<uint8> Data;
+		int32                  Offset;
+	};
+
+	auto reader = FRestoreReader{payload, 0};
+	auto err = ecsact_restore_entities(
+		registry_id,
+		[](void* out_data, int32_t data_max_length, void* user_data) -> int32_t {
+			auto reader = static_cast<FRestoreReader*>(user_data);
+			auto read_length =
+				FMath::Min(data_max_length, reader->Data.Num() - reader->Offset);
+			FMemory::Memcpy(
+				out_data,
+				reader->Data.GetData() + reader->Offset,
+				read_length
+			);
+			reader->Offset += read_length;
+			return read_length;
+		},
+		EventsCollector,
+		&reader
+	);
+
+	if(err != ECSACT_RESTORE_OK) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("Failed to restore Ecsact snapshot (error %i)"),
+			static_cast<int32>(err)
+		);
+		return false;
+	}
+
+	return true;
+}
+
+auto UEcsactSyncRunner::SetRollbackHistoryLength(int32 HistoryTicks) -> void {
+	LLM_SCOPE_BYTAG(Ecsact_Snapshots);
+	RollbackHistory.Reset();
+	RollbackHistory.SetNum(FMath::Max(HistoryTicks, 0));
+}
+
+auto UEcsactSyncRunner::RecordRollbackInputs(
+	FEcsactSyncRunnerRollbackFrame&      Frame,
+	const UEcsactUnrealExecutionOptions& Options
+) -> void {
+	Frame.Inputs.Reset();
+	RollbackRecorder.OpenMemory(Frame.Inputs);
+	RollbackRecorder.Record(Frame.Tick, Options);
+	RollbackRecorder.Close();
+}
+
+auto UEcsactSyncRunner::RecordRollbackFrame() -> void {
+	if(RollbackHistory.IsEmpty()) {
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Ecsact_Snapshots);
+	auto& frame = RollbackHistory[CurrentTick % RollbackHistory.Num()];
+	frame.Tick = CurrentTick;
+	frame.bSnapshotValid = SaveSnapshot(frame.Snapshot, false);
+	if(ExecutionOptions != nullptr) {
+		RecordRollbackInputs(frame, *ExecutionOptions);
+	} else {
+		frame.Inputs.Reset();
+	}
+}
+
+auto UEcsactSyncRunner::Rollback(
+	int32                          Tick,
+	UEcsactUnrealExecutionOptions* CorrectedInputs
+) -> bool {
+	if(RollbackHistory.IsEmpty()) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("Rollback: history is disabled. See SetRollbackHistoryLength")
+		);
+		return false;
+	}
+	if(ecsact_count_entities == nullptr || ecsact_get_entities == nullptr ||
+		 ecsact_each_component == nullptr ||
+		 ecsact_serialize_component_size == nullptr) {
+		UE_LOG(Ecsact, Error, TEXT("Rollback: Ecsact runtime is missing methods"));
+		return false;
+	}
+
+	auto history_num = RollbackHistory.Num();
+	auto oldest_tick = FMath::Max(CurrentTick - history_num, 0);
+	if(Tick < oldest_tick || Tick >= CurrentTick ||
+		 RollbackHistory[Tick % history_num].Tick != Tick) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("Rollback: tick %i is outside of the rollback history (%i-%i)"),
+			Tick,
+			oldest_tick,
+			CurrentTick - 1
+		);
+		return false;
+	}
+
+	if(CorrectedInputs != nullptr) {
+		RecordRollbackInputs(
+			RollbackHistory[Tick % history_num],
+			*CorrectedInputs
+		);
+	}
+
+	auto start_tick = Tick;
+	while(start_tick >= oldest_tick) {
+		const auto& frame = RollbackHistory[start_tick % history_num];
+		if(frame.Tick == start_tick && frame.bSnapshotValid) {
+			break;
+		}
+		start_tick -= 1;
+	}
+	if(start_tick < oldest_tick) {
+		UE_LOG(
+			Ecsact,
+			Error,
+			TEXT("Rollback: no snapshot at or before tick %i"),
+			Tick
+		);
+		return false;
+	}
+
+	auto inputs = TArray<uint8>{};
+	for(auto tick = start_tick; CurrentTick > tick; ++tick) {
+		inputs.Append(RollbackHistory[tick % history_num].Inputs);
+	}
+
+	auto recording = FEcsactExecutionRecording{};
+	if(!recording.LoadFrames(MoveTemp(inputs))) {
+		return false;
+	}
+
+	// Ticks without inputs were not recorded so spread the frames out
+	auto exec_opts = TArray<ecsact_execution_options>{};
+	exec_opts.SetNumZeroed(CurrentTick - start_tick);
+	for(auto i = 0; recording.Num() > i; ++i) {
+		exec_opts[recording.GetTick(i) - start_tick] = recording.GetOptions()[i];
+	}
+
+	auto before = CaptureRegistryState(registry_id);
+	auto& snapshot = RollbackHistory[start_tick % history_num].Snapshot;
+	if(!RestoreSnapshot(snapshot, nullptr)) {
+		return false;
+	}
+
+	auto err = ecsact_execute_systems(
+		registry_id,
+		exec_opts.Num(),
+		exec_opts.GetData(),
+		nullptr
+	);
+	if(err != ECSACT_EXEC_SYS_OK) {
+		UE_LOG(Ecsact, Error, TEXT("Rollback: Ecsact execution failed"));
+	}
+
+	// Snapshots after the corrected tick no longer match the re-simulation
+	for(auto tick = Tick + 1; CurrentTick > tick; ++tick) {
+		RollbackHistory[tick % history_num].bSnapshotValid = false;
+	}
+
+	EventRegistry = registry_id;
+	DispatchStateDiff(
+		before,
+		CaptureRegistryState(registry_id),
+		GetEventsCollector()
+	);
+	return err == ECSACT_EXEC_SYS_OK;
+}
+
+auto UEcsactSyncRunner::PreRuntimeReload() -> void {
+	RuntimeReloadSnapshot.Reset();
+	if(registry_id != ECSACT_INVALID_ID(registry)) {
+		SaveSnapshot(RuntimeReloadSnapshot, false);
+	}
+
+	if(!AdditionalRegistries.IsEmpty()) {
+		UE_LOG(
+			Ecsact,
+			Warning,
+			TEXT("Registries added with AddRegistry are lost on runtime reload")
+		);
+		AdditionalRegistries.Empty();
+		AdditionalExecutionOptions.Empty();
+	}
+
+	// Old snapshots and ids belong to the unloaded runtime
+	SetRollbackHistoryLength(GetRollbackHistoryLength());
+	registry_id = ECSACT_INVALID_ID(registry);
+	Super::PreRuntimeReload();
+}
+
+auto UEcsactSyncRunner::PostRuntimeReload() -> void {
+	Super::PostRuntimeReload();
+
+	if(RuntimeReloadSnapshot.IsEmpty()) {
+		return;
+	}
+
+	if(ecsact_create_registry) {
+		registry_id = ecsact_create_registry("Default Registry");
+		LoadSnapshot(RuntimeReloadSnapshot);
+	}
+	RuntimeReloadSnapshot.Empty();
+}
+
 auto UEcsactSyncRunner::Tick(float DeltaTime) -> void {
 	if(ecsact_execute_systems == nullptr) {
 		UE_LOG(Ecsact, Error, TEXT("ecsact_execute_systems is unavailable"));
@@ -53,8 +632,15 @@ auto UEcsactSyncRunner::Tick(float DeltaTime) -> void {
 		}
 	}
 
+	ExecuteAdditionalRegistries();
+
 	if(registry_id != ECSACT_INVALID_ID(registry)) {
+		EventRegistry = registry_id;
 		if(ecsact_execute_systems) {
+			RecordExecutionOptions();
+			RecordRollbackFrame();
+			UpdateMemoryStats();
+
 			ecsact_execution_options* exec_opts = nullptr;
 			if(ExecutionOptions != nullptr && ExecutionOptions->IsNotEmpty()) {
 				exec_opts = ExecutionOptions->GetCPtr();
@@ -68,6 +654,7 @@ auto UEcsactSyncRunner::Tick(float DeltaTime) -> void {
 			if(err != ECSACT_EXEC_SYS_OK) {
 				UE_LOG(Ecsact, Error, TEXT("Ecsact execution failed"));
 			}
+			CurrentTick += 1;
 			if(ExecutionOptions != nullptr) {
 				ExecutionOptions->Clear();
 			}
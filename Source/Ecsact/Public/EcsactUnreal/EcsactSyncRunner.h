@@ -13,6 +13,31 @@
 #include "ecsact/runtime/common.h"
 #include "EcsactSyncRunner.generated.h"
 
+/**
+ * @internal - state for registries added with UEcsactSyncRunner::AddRegistry
+ */
+struct FEcsactSyncRunnerRegistry {
+	ecsact_registry_id                Id;
+	TArray<uint8>                     Events;
+	FEcsactEventRecorder              Recorder;
+	ecsact_execution_events_collector EventsCollector;
+	ecsact_execute_systems_error      LastError;
+};
+
+/**
+ * @internal - one tick of rollback history kept by UEcsactSyncRunner
+ */
+struct FEcsactSyncRunnerRollbackFrame {
+	int32 Tick = INDEX_NONE;
+	bool  bSnapshotValid = false;
+
+	/** Uncompressed SaveSnapshot taken before the tick executed. */
+	TArray<uint8> Snapshot;
+
+	/** Frame written by FEcsactExecutionRecorder::OpenMemory (empty if none.) */
+	TArray<uint8> Inputs;
+};
+
 UCLASS(NotBlueprintable)
 
 class ECSACT_API UEcsactSyncRunner : public UEcsactRunner {
@@ -20,6 +45,33 @@ class ECSACT_API UEcsactSyncRunner : public UEcsactRunner {
 
 	float LastTickTime = 0.f;
 
+	TArray<TUniquePtr<FEcsactSyncRunnerRegistry>> AdditionalRegistries;
+
+	/** Execution options for AdditionalRegistries (same order.) */
+	UPROPERTY()
+	TArray<UEcsactUnrealExecutionOptions*> AdditionalExecutionOptions;
+
+	ecsact_registry_id EventRegistry = ECSACT_INVALID_ID(registry);
+
+	/** Ring buffer indexed by tick. Empty when rollback is disabled. */
+	TArray<FEcsactSyncRunnerRollbackFrame> RollbackHistory;
+	FEcsactExecutionRecorder               RollbackRecorder;
+	int32                                  CurrentTick = 0;
+
+	/** registry_id snapshot kept across FEcsactGameModuleImpl::ReloadRuntime */
+	TArray<uint8> RuntimeReloadSnapshot;
+
+	auto ExecuteAdditionalRegistries() -> void;
+	auto RecordRollbackFrame() -> void;
+	auto RecordRollbackInputs(
+		FEcsactSyncRunnerRollbackFrame&      Frame,
+		const UEcsactUnrealExecutionOptions& Options
+	) -> void;
+	auto RestoreSnapshot(
+		TConstArrayView<uint8>                   Snapshot,
+		const ecsact_execution_events_collector* EventsCollector
+	) -> bool;
+
 protected:
 	auto StreamImpl(
 		ecsact_entity_id    Entity,
@@ -33,6 +85,88 @@ public:
 
 	UEcsactSyncRunner();
 
+	/** Fails if registry_id already has entities. */
+	auto StartRecording(const FString& Path) -> bool override;
+
+	/**
+	 * Creates a registry that is executed alongside registry_id every tick.
+	 * Additional registries are executed in parallel on task graph workers and
+	 * their events are dispatched afterwards on the game thread to runner
+	 * subsystems with bReceiveAdditionalRegistryEvents. Use GetEventRegistry to
+	 * tell which registry an event came from.
+	 */
+	auto AddRegistry(const FString& Name) -> ecsact_registry_id;
+
+	/**
+	 * Destroys a registry created with AddRegistry.
+	 */
+	auto RemoveRegistry(ecsact_registry_id Registry) -> void;
+
+	/**
+	 * Execution options submitted to @p Registry next tick. Returns nullptr if
+	 * @p Registry was not created with AddRegistry.
+	 */
+	auto GetRegistryExecutionOptions( //
+		ecsact_registry_id Registry
+	) -> UEcsactUnrealExecutionOptions*;
+
+	/**
+	 * The registry whose events are currently being dispatched. Only meaningful
+	 * inside runner subsystem event callbacks.
+	 */
+	auto GetEventRegistry() const -> ecsact_registry_id {
+		return EventRegistry;
+	}
+
+	/**
+	 * Serializes every entity and component in registry_id into
+	 * @p OutSnapshot via `ecsact_dump_entities`. Zlib compressed when
+	 * @p bCompress is set.
+	 */
+	auto SaveSnapshot(TArray<uint8>& OutSnapshot, bool bCompress = true) -> bool;
+
+	/**
+	 * Restores a snapshot made by SaveSnapshot into registry_id via
+	 * `ecsact_restore_entities`. Runner subsystems receive events for the
+	 * restored entities and components.
+	 */
+	auto LoadSnapshot(TConstArrayView<uint8> Snapshot) -> bool;
+
+	/**
+	 * Keep a snapshot and the submitted execution options for the last
+	 * @p HistoryTicks ticks so Rollback can re-simulate them. Taking a snapshot
+	 * every tick is not free; 0 (the default) disables rollback.
+	 */
+	auto SetRollbackHistoryLength(int32 HistoryTicks) -> void;
+
+	auto GetRollbackHistoryLength() const -> int32 {
+		return RollbackHistory.Num();
+	}
+
+	/**
+	 * Number of ticks registry_id has executed.
+	 */
+	auto GetCurrentTick() const -> int32 {
+		return CurrentTick;
+	}
+
+	/**
+	 * Restores registry_id to the state before @p Tick and re-executes every
+	 * tick since in a single batched `ecsact_execute_systems` call. If
+	 * @p CorrectedInputs is given it replaces the inputs recorded for @p Tick.
+	 *
+	 * No events are dispatched during the re-simulation. Instead runner
+	 * subsystems receive the difference between the registry before and after
+	 * the rollback once it is done.
+	 */
+	auto Rollback(
+		int32                          Tick,
+		UEcsactUnrealExecutionOptions* CorrectedInputs = nullptr
+	) -> bool;
+
+	auto PreRuntimeReload() -> void override;
+	auto PostRuntimeReload() -> void override;
+
 	auto Tick(float DeltaTime) -> void override;
 	auto GetStatId() const -> TStatId override;
 };
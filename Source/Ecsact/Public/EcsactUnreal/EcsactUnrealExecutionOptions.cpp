@@ -17,6 +17,45 @@ auto UEcsactUnrealExecutionOptions::GetCPtr() -> ecsact_execution_options* {
 	return &ExecOpts;
 }
 
+auto UEcsactUnrealExecutionOptions::PushActionRaw(
+	ecsact_action_id ActionId,
+	const void*      ActionData,
+	int32            ActionSize
+) -> void {
+	LLM_SCOPE_BYTAG(Ecsact_ExecutionOptions);
+	auto action_data = FMemory::Malloc(ActionSize);
+	FMemory::Memcpy(action_data, ActionData, ActionSize);
+	ActionList.Push(ecsact_action{
+		.action_id = ActionId,
+		.action_data = action_data,
+	});
+	ActionSizeList.Push(ActionSize);
+
+	ExecOpts.actions_length = ActionList.Num();
+	ExecOpts.actions = ActionList.GetData();
+}
+
+auto UEcsactUnrealExecutionOptions::UpdateComponentRaw(
+	ecsact_entity_id    Entity,
+	ecsact_component_id ComponentId,
+	const void*         ComponentData,
+	int32               ComponentSize
+) -> void {
+	LLM_SCOPE_BYTAG(Ecsact_ExecutionOptions);
+	auto component_data = FMemory::Malloc(ComponentSize);
+	FMemory::Memcpy(component_data, ComponentData, ComponentSize);
+	UpdateComponentList.Push(ecsact_component{
+		.component_id = ComponentId,
+		.component_data = component_data,
+	});
+	UpdateComponentEntityList.Push(Entity);
+	UpdateComponentSizeList.Push(ComponentSize);
+
+	ExecOpts.update_components_length = UpdateComponentList.Num();
+	ExecOpts.update_components_entities = UpdateComponentEntityList.GetData();
+	ExecOpts.update_components = UpdateComponentList.GetData();
+}
+
 auto UEcsactUnrealExecutionOptions::IsNotEmpty() const -> bool {
 	return ExecOpts.actions_length > 0 || ExecOpts.create_entities_length > 0 ||
 		ExecOpts.add_components_length > 0 ||
@@ -40,14 +79,64 @@ auto UEcsactUnrealExecutionOptions::Clear() -> void {
 	AddComponentList.Empty();
 	UpdateComponentList.Empty();
 	RemoveComponentList.Empty();
+	AddComponentEntityList.Empty();
+	UpdateComponentEntityList.Empty();
+	RemoveComponentEntityList.Empty();
+	ActionSizeList.Empty();
+	AddComponentSizeList.Empty();
+	UpdateComponentSizeList.Empty();
 	DestroyEntityList.Empty();
 	CreateEntityList.Empty();
 	CreateEntityComponentsList.Empty();
+	CreateEntityComponentSizesList.Empty();
 	CreateEntityComponentsListData.Empty();
 	CreateEntityComponentsListNums.Empty();
 	ExecOpts = {};
 }
 
+auto UEcsactUnrealExecutionOptions::GetAllocatedSize() const -> SIZE_T {
+	auto size = ActionList.GetAllocatedSize() +
+		AddComponentList.GetAllocatedSize() +
+		UpdateComponentList.GetAllocatedSize() +
+		RemoveComponentList.GetAllocatedSize() +
+		AddComponentEntityList.GetAllocatedSize() +
+		UpdateComponentEntityList.GetAllocatedSize() +
+		RemoveComponentEntityList.GetAllocatedSize() +
+		ActionSizeList.GetAllocatedSize() +
+		AddComponentSizeList.GetAllocatedSize() +
+		UpdateComponentSizeList.GetAllocatedSize() +
+		CreateEntityList.GetAllocatedSize() +
+		CreateEntityComponentsList.GetAllocatedSize() +
+		CreateEntityComponentSizesList.GetAllocatedSize() +
+		CreateEntityComponentsListData.GetAllocatedSize() +
+		CreateEntityComponentsListNums.GetAllocatedSize() +
+		DestroyEntityList.GetAllocatedSize();
+
+	auto add_payloads = [&size](const TArray<int32>& Sizes) {
+		for(auto payload_size : Sizes) {
+			size += payload_size;
+		}
+	};
+
+	add_payloads(ActionSizeList);
+	add_payloads(AddComponentSizeList);
+	add_payloads(UpdateComponentSizeList);
+	for(auto i = 0; CreateEntityComponentsList.Num() > i; ++i) {
+		size += CreateEntityComponentsList[i].GetAllocatedSize();
+		size += CreateEntityComponentSizesList[i].GetAllocatedSize();
+		add_payloads(CreateEntityComponentSizesList[i]);
+	}
+
+	return size;
+}
+
+auto UEcsactUnrealExecutionOptions::GetResourceSizeEx(
+	FResourceSizeEx& CumulativeResourceSize
+) -> void {
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetAllocatedSize());
+}
+
 #if WITH_EDITORONLY_DATA
 auto UEcsactUnrealExecutionOptions::DebugLog() const -> void {
 	if(!IsNotEmpty()) {
@@ -114,11 +203,13 @@ CreateEntityBuilder::CreateEntityBuilder(CreateEntityBuilder&& Other) {
 	Owner = Other.Owner;
 	PlaceholderId = Other.PlaceholderId;
 	ComponentList = std::move(Other.ComponentList);
+	ComponentSizeList = std::move(Other.ComponentSizeList);
 
 	Other.bValid = false;
 	Other.Owner = nullptr;
 	Other.PlaceholderId = {};
 	Other.ComponentList = {};
+	Other.ComponentSizeList = {};
 }
 
 auto CreateEntityBuilder::operator=( //
@@ -128,14 +219,32 @@ auto CreateEntityBuilder::operator=( //
 	Owner = Other.Owner;
 	PlaceholderId = Other.PlaceholderId;
 	ComponentList = std::move(Other.ComponentList);
+	ComponentSizeList = std::move(Other.ComponentSizeList);
 
 	Other.bValid = false;
 	Other.Owner = nullptr;
 	Other.PlaceholderId = {};
 	Other.ComponentList = {};
+	Other.ComponentSizeList = {};
 	return *this;
 }
 
+auto CreateEntityBuilder::AddComponentRaw(
+	ecsact_component_id ComponentId,
+	const void*         ComponentData,
+	int32               ComponentSize
+) && -> CreateEntityBuilder {
+	LLM_SCOPE_BYTAG(Ecsact_ExecutionOptions);
+	auto component_data = FMemory::Malloc(ComponentSize);
+	FMemory::Memcpy(component_data, ComponentData, ComponentSize);
+	ComponentList.Push(ecsact_component{
+		.component_id = ComponentId,
+		.component_data = component_data,
+	});
+	ComponentSizeList.Push(ComponentSize);
+	return std::move(*this);
+}
+
 CreateEntityBuilder::~CreateEntityBuilder() {
 	if(bValid) {
 		Finish();
@@ -152,9 +261,12 @@ auto CreateEntityBuilder::Finish() -> void {
 		return;
 	}
 
+	LLM_SCOPE_BYTAG(Ecsact_ExecutionOptions);
+
 	Owner->CreateEntityList.Add(PlaceholderId);
 	Owner->CreateEntityComponentsListNums.Add(ComponentList.Num());
 	Owner->CreateEntityComponentsList.Push(std::move(ComponentList));
+	Owner->CreateEntityComponentSizesList.Push(std::move(ComponentSizeList));
 	Owner->CreateEntityComponentsListData.Empty();
 	for(auto& list : Owner->CreateEntityComponentsList) {
 		Owner->CreateEntityComponentsListData.Add(list.GetData());
@@ -170,4 +282,5 @@ auto CreateEntityBuilder::Finish() -> void {
 	bValid = false;
 	Owner = nullptr;
 	ComponentList = {};
+	ComponentSizeList = {};
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "EcsactUnreal/EcsactMemory.h"
 #include "ecsact/runtime/common.h"
 #include "EcsactUnrealExecutionOptions.generated.h"
 
@@ -15,13 +16,25 @@ UCLASS()
 class ECSACT_API UEcsactUnrealExecutionOptions : public UObject {
 	GENERATED_BODY() // NOLINT
 
+	friend class FEcsactExecutionRecorder;
+
 	TArray<ecsact_action>       ActionList;
 	TArray<ecsact_component>    AddComponentList;
 	TArray<ecsact_component>    UpdateComponentList;
 	TArray<ecsact_component_id> RemoveComponentList;
 
+	TArray<ecsact_entity_id> AddComponentEntityList;
+	TArray<ecsact_entity_id> UpdateComponentEntityList;
+	TArray<ecsact_entity_id> RemoveComponentEntityList;
+
+	/** Payload sizes parallel to the action/component lists. */
+	TArray<int32> ActionSizeList;
+	TArray<int32> AddComponentSizeList;
+	TArray<int32> UpdateComponentSizeList;
+
 	TArray<ecsact_placeholder_entity_id> CreateEntityList;
 	TArray<TArray<ecsact_component>>     CreateEntityComponentsList;
+	TArray<TArray<int32>>                CreateEntityComponentSizesList;
 
 	TArray<ecsact_component*> CreateEntityComponentsListData;
 	TArray<int>               CreateEntityComponentsListNums;
@@ -39,6 +52,15 @@ public:
 	auto Clear() -> void;
 	auto IsNotEmpty() const -> bool;
 
+	/**
+	 * Bytes held by the pending execution options including copied action and
+	 * component payloads.
+	 */
+	auto GetAllocatedSize() const -> SIZE_T;
+
+	auto GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) //
+		-> void override;
+
 #ifdef WITH_EDITORONLY_DATA
 	auto DebugLog() const -> void;
 #endif
@@ -60,55 +82,68 @@ public:
 	) -> CreateEntityBuilder;
 
 	inline auto DestroyEntity(ecsact_entity_id Entity) -> void {
+		LLM_SCOPE_BYTAG(Ecsact_ExecutionOptions);
 		DestroyEntityList.Add(Entity);
 		ExecOpts.destroy_entities_length = DestroyEntityList.Num();
 		ExecOpts.destroy_entities = DestroyEntityList.GetData();
 	}
 
+	/**
+	 * Push an action by id. @p ActionData is copied. Prefer `PushAction<A>`
+	 * when the action type is known at compile time.
+	 */
+	auto PushActionRaw(
+		ecsact_action_id ActionId,
+		const void*      ActionData,
+		int32            ActionSize
+	) -> void;
+
 	template<typename A>
 	auto PushAction(const A& Action) -> void {
-		auto action_data = FMemory::Malloc(sizeof(A));
-		FMemory::Memcpy(action_data, &Action, sizeof(A));
-		ActionList.Push(ecsact_action{
-			.action_id = A::id,
-			.action_data = action_data,
-		});
-
-		ExecOpts.actions_length = ActionList.Num();
-		ExecOpts.actions = ActionList.GetData();
+		return PushActionRaw(A::id, &Action, sizeof(A));
 	}
 
 	template<typename C>
 	auto AddComponent(ecsact_entity_id Entity, const C& Component) -> void {
+		LLM_SCOPE_BYTAG(Ecsact_ExecutionOptions);
 		auto component_data = FMemory::Malloc(sizeof(C));
 		FMemory::Memcpy(component_data, &Component, sizeof(C));
 		AddComponentList.Push(ecsact_component{
 			.component_id = C::id,
 			.component_data = component_data,
 		});
+		AddComponentEntityList.Push(Entity);
+		AddComponentSizeList.Push(sizeof(C));
 
 		ExecOpts.add_components_length = AddComponentList.Num();
+		ExecOpts.add_components_entities = AddComponentEntityList.GetData();
 		ExecOpts.add_components = AddComponentList.GetData();
 	}
 
+	/**
+	 * Update a component by id. @p ComponentData is copied. Prefer
+	 * `UpdateComponent<C>` when the component type is known at compile time.
+	 */
+	auto UpdateComponentRaw(
+		ecsact_entity_id    Entity,
+		ecsact_component_id ComponentId,
+		const void*         ComponentData,
+		int32               ComponentSize
+	) -> void;
+
 	template<typename C>
 	auto UpdateComponent(ecsact_entity_id Entity, const C& Component) -> void {
-		auto component_data = FMemory::Malloc(sizeof(C));
-		FMemory::Memcpy(component_data, &Component, sizeof(C));
-		UpdateComponentList.Push(ecsact_component{
-			.component_id = C::id,
-			.component_data = component_data,
-		});
-
-		ExecOpts.update_components_length = UpdateComponentList.Num();
-		ExecOpts.update_components = UpdateComponentList.GetData();
+		return UpdateComponentRaw(Entity, C::id, &Component, sizeof(C));
 	}
 
 	template<typename C>
 	auto RemoveComponent(ecsact_entity_id Entity) -> void {
+		LLM_SCOPE_BYTAG(Ecsact_ExecutionOptions);
 		RemoveComponentList.Push(C::id);
+		RemoveComponentEntityList.Push(Entity);
 
 		ExecOpts.remove_components_length = RemoveComponentList.Num();
+		ExecOpts.remove_components_entities = RemoveComponentEntityList.GetData();
 		ExecOpts.remove_components = RemoveComponentList.GetData();
 	}
 };
@@ -119,6 +154,7 @@ class ECSACT_API UEcsactUnrealExecutionOptions::CreateEntityBuilder {
 	UEcsactUnrealExecutionOptions* Owner;
 	ecsact_placeholder_entity_id   PlaceholderId;
 	TArray<ecsact_component>       ComponentList;
+	TArray<int32>                  ComponentSizeList;
 
 	CreateEntityBuilder(
 		UEcsactUnrealExecutionOptions* Owner,
@@ -131,15 +167,18 @@ public:
 
 	auto operator=(CreateEntityBuilder&&) -> CreateEntityBuilder&;
 
+	/**
+	 * Add a component by id. @p ComponentData is copied.
+	 */
+	auto AddComponentRaw(
+		ecsact_component_id ComponentId,
+		const void*         ComponentData,
+		int32               ComponentSize
+	) && -> CreateEntityBuilder;
+
 	template<typename C>
 	auto AddComponent(const C& Component) && -> CreateEntityBuilder {
-		auto component_data = FMemory::Malloc(sizeof(C));
-		FMemory::Memcpy(component_data, &Component, sizeof(C));
-		ComponentList.Push(ecsact_component{
-			.component_id = C::id,
-			.component_data = component_data,
-		});
-		return std::move(*this);
+		return std::move(*this).AddComponentRaw(C::id, &Component, sizeof(C));
 	}
 
 	/**
@@ -22,8 +22,10 @@
 	fn = reinterpret_cast<decltype(fn)>(                                    \
 		FPlatformProcess::GetDllExport(ecsact_runtime_dll_handle_, TEXT(#fn)) \
 	);                                                                      \
+	total_fn_count_ += 1;                                                   \
 	if(fn != nullptr) {                                                     \
-		UE_LOG(Ecsact, Log, TEXT("loaded %s"), TEXT(#fn));                    \
+		loaded_fn_count_ += 1;                                                \
+		UE_LOG(Ecsact, Verbose, TEXT("loaded %s"), TEXT(#fn));                \
 	}                                                                       \
 	static_assert(true, "require ;")
 
@@ -45,6 +47,9 @@
  * ECSACT_LOAD_RUNTIME() multiple times without calling ECSACT_UNLOAD_RUNTIME()
  * is not allowed.
  *
+ * Only a one line summary is logged. Use `-LogCmds="Ecsact Verbose"` to log
+ * every loaded function.
+ *
  * NOTE: this is a preprocessor macro so that the function pointers in your
  * hot-reloaded module are correct. Otherwise the loaded function pointers will
  * only be on the initial process's DLLs.
@@ -56,7 +61,8 @@
  */
 #	define ECSACT_LOAD_RUNTIME()                                            \
 		([]() -> FEcsactRuntimeHandle {                                        \
-			auto module = FEcsactModule::Get();                                  \
+			auto load_start_time_ = FPlatformTime::Seconds();                    \
+			auto& module = FEcsactModule::Get();                                 \
 			if(!EcsactUnreal::Detail::CheckRuntimeNotLoaded(module)) {           \
 				return {};                                                         \
 			}                                                                    \
@@ -70,8 +76,15 @@
 			if(!EcsactUnreal::Detail::CheckRuntimeHandle(module, result)) {      \
 				return {};                                                         \
 			}                                                                    \
+			auto total_fn_count_ = int32{};                                      \
+			auto loaded_fn_count_ = int32{};                                     \
 			FOR_EACH_ECSACT_API_FN(ECSACTAPI_FN_FN_LOAD_);                       \
 			FOR_EACH_ECSACT_SI_WASM_API_FN(ECSACTAPI_FN_FN_LOAD_);               \
+			EcsactUnreal::Detail::LogRuntimeLoaded(                              \
+				loaded_fn_count_,                                                  \
+				total_fn_count_,                                                   \
+				load_start_time_                                                   \
+			);                                                                   \
 			return result;                                                       \
 		})()
 
@@ -80,7 +93,7 @@
  */
 #	define ECSACT_UNLOAD_RUNTIME(Handle)                             \
 		([](FEcsactRuntimeHandle& Handle_) -> void {                    \
-			auto module = FEcsactModule::Get();                           \
+			auto& module = FEcsactModule::Get();                          \
 			if(!EcsactUnreal::Detail::CheckUnloadable(module, Handle_)) { \
 				return;                                                     \
 			}                                                             \
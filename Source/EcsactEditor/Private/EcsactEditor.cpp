@@ -5,8 +5,11 @@
 // online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
 
 #include "EcsactEditor.h"
+#include <atomic>
+#include "EcsactFileIndex.h"
 #include "Async/Async.h"
 #include "Async/TaskGraphInterfaces.h"
+#include "HAL/CriticalSection.h"
 #include "Interfaces/IPluginManager.h"
 #include "CoreGlobals.h"
 #include "EcsactUnreal/Ecsact.h"
@@ -16,13 +19,18 @@
 #include "ISettingsSection.h"
 #include "ISettingsContainer.h"
 #include "LevelEditor.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformFileManager.h"
 #include "DirectoryWatcherModule.h"
 #include "IDirectoryWatcher.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "Framework/MultiBox/MultiBoxExtender.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
 #include "Serialization/JsonReader.h"
 #include "EcsactUnreal/EcsactSettings.h"
+#include "EcsactUnreal/EcsactGameModuleImpl.h"
 #include "EcsactUnreal/EcsactRunnerSubsystem.h"
 #include "Engine/Blueprint.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -47,6 +55,31 @@ static auto SourceDir() -> FString {
 	return FPaths::Combine(FPaths::ProjectDir(), "Source");
 }
 
+static auto BuildCacheDir() -> FString {
+	return FPaths::ConvertRelativePathToFull(FPaths::Combine(
+		FPaths::ProjectIntermediateDir(),
+		TEXT("Ecsact"),
+		TEXT("Build")
+	));
+}
+
+/**
+ * Time without further .ecsact file changes before a build starts.
+ */
+static constexpr auto BuildDebounceSeconds = 0.5f;
+
+static auto BuildHashPath() -> FString {
+	return FPaths::Combine(BuildCacheDir(), TEXT("BuildHash.txt"));
+}
+
+/**
+ * Moves @p Src over @p Dst. Both are expected on the same volume so this is a
+ * rename and @p Dst is never left partially written.
+ */
+static auto MoveStagedFile(const FString& Src, const FString& Dst) -> bool {
+	return IFileManager::Get().Move(*Dst, *Src, true, true);
+}
+
 static auto PlatformBinariesDirname() -> FString {
 	auto platform_name = FString{FPlatformProperties::PlatformName()};
 
@@ -145,18 +178,144 @@ auto FEcsactEditorModule::GetEcsactCli() -> FString {
 	return GetEcsactSdkBinaryPath("ecsact");
 }
 
+auto FEcsactEditorModule::GetEcsactSdkVersion() -> FString {
+	if(EcsactSdkVersion.IsEmpty()) {
+		auto return_code = int32{};
+		auto std_out = FString{};
+		FPlatformProcess::ExecProcess(
+			*GetEcsactCli(),
+			TEXT("--version"),
+			&return_code,
+			&std_out,
+			nullptr
+		);
+		if(return_code == 0) {
+			EcsactSdkVersion = std_out.TrimStartAndEnd();
+		}
+	}
+	return EcsactSdkVersion;
+}
+
+auto FEcsactEditorModule::GetBuildHash(
+	const TArray<FString>& EcsactFiles,
+	const TArray<FString>& Recipes,
+	const FString&         RuntimePath
+) -> FString {
+	auto sha = FSHA1{};
+	auto update_string = [&sha](const FString& Str) {
+		auto utf8 = FTCHARToUTF8(*Str);
+		// Include the null terminator so adjacent strings can't collide
+		sha.Update(reinterpret_cast<const uint8*>(utf8.Get()), utf8.Length() + 1);
+	};
+	auto update_file = [&sha](const FString& Path) {
+		auto contents = TArray<uint8>{};
+		if(FFileHelper::LoadFileToArray(contents, *Path, FILEREAD_Silent)) {
+			sha.Update(contents.GetData(), contents.Num());
+		}
+	};
+
+	update_string(GetEcsactSdkVersion());
+	update_string(RuntimePath);
+
+	for(const auto& recipe : Recipes) {
+		update_string(recipe);
+		auto recipe_path = FPaths::Combine(FPaths::ProjectDir(), recipe);
+		if(FPaths::FileExists(recipe_path)) {
+			update_file(recipe_path);
+		} else if(FPaths::FileExists(recipe)) {
+			update_file(recipe);
+		}
+	}
+
+	for(const auto& file : EcsactFiles) {
+		update_string(file);
+		update_file(file);
+	}
+
+	sha.Final();
+	auto hash = FSHAHash{};
+	sha.GetHash(hash.Hash);
+	return hash.ToString();
+}
+
+/**
+ * Output lines of an ecsact CLI process waiting to be delivered on the game
+ * thread. Only one game thread task is queued at a time so verbose output is
+ * delivered in batches instead of one task per line.
+ */
+class FEcsactCliLineBatcher
+	: public TSharedFromThis<FEcsactCliLineBatcher, ESPMode::ThreadSafe> {
+	FCriticalSection                     Lock;
+	TArray<FString>                      PendingLines;
+	std::atomic<bool>                    bFlushQueued = false;
+	FEcsactEditorModule::FOnReceiveLine OnReceiveLine;
+
+public:
+	FEcsactCliLineBatcher(FEcsactEditorModule::FOnReceiveLine InOnReceiveLine)
+		: OnReceiveLine(std::move(InOnReceiveLine)) {
+	}
+
+	/**
+	 * Moves @p Lines into the pending batch. May be called from any thread.
+	 */
+	auto Push(TArray<FString>& Lines) -> void {
+		if(Lines.IsEmpty()) {
+			return;
+		}
+
+		{
+			auto lock = FScopeLock{&Lock};
+			PendingLines.Append(MoveTemp(Lines));
+		}
+		Lines.Reset();
+
+		if(!bFlushQueued.exchange(true)) {
+			AsyncTask(ENamedThreads::GameThread, [self = AsShared()] {
+				self->Flush();
+			});
+		}
+	}
+
+	/**
+	 * Delivers all pending lines. Must be called on the game thread.
+	 */
+	auto Flush() -> void {
+		check(IsInGameThread());
+
+		bFlushQueued = false;
+		auto lines = TArray<FString>{};
+		{
+			auto lock = FScopeLock{&Lock};
+			Swap(lines, PendingLines);
+		}
+
+		for(const auto& line : lines) {
+			OnReceiveLine.ExecuteIfBound(line);
+		}
+	}
+};
+
 auto FEcsactEditorModule::SpawnEcsactCli(
 	const TArray<FString>& Args,
 	FOnReceiveLine         OnReceiveLine,
-	FOnExitDelegate        OnExit
+	FOnExitDelegate        OnExit,
+	FCancelFlag            CancelFlag
 ) -> void {
 	check(OnExit.IsBound());
 
+	// Unreal pipes can only be read without blocking so an idle reader waits
+	// this long before polling again
+	constexpr auto idle_pipe_wait_seconds = 0.01f;
+
 	auto args_str = FString{};
 	for(const auto& arg : Args) {
 		args_str += "\"" + arg + "\" ";
 	}
 
+	auto batcher = MakeShared<FEcsactCliLineBatcher, ESPMode::ThreadSafe>( //
+		std::move(OnReceiveLine)
+	);
+
 	AsyncTask(
 		ENamedThreads::AnyBackgroundThreadNormalTask,
 		[=, this, OnExit = std::move(OnExit)] {
@@ -181,30 +340,66 @@ auto FEcsactEditorModule::SpawnEcsactCli(
 				PipeReadChild
 			);
 
-			auto read_buf = FString{};
-			auto read_line = [&]() -> FString {
-				read_buf += FPlatformProcess::ReadPipe(PipeReadParent);
-				auto nl_index = int32{};
-				if(read_buf.FindChar(TCHAR('\n'), nl_index)) {
-					auto line = read_buf.Mid(0, nl_index);
-					read_buf = read_buf.Mid(nl_index + 1);
-					return line;
+			// Bytes read from the pipe that are not yet a complete line. The
+			// buffer keeps its capacity so steady output doesn't reallocate.
+			auto pending = TArray<uint8>{};
+			auto chunk = TArray<uint8>{};
+			auto lines = TArray<FString>{};
+
+			auto add_line = [&](int32 Start, int32 End) {
+				if(End > Start && pending[End - 1] == '\r') {
+					End -= 1;
+				}
+				if(End > Start) {
+					auto utf8 = FUTF8ToTCHAR(
+						reinterpret_cast<const ANSICHAR*>(pending.GetData() + Start),
+						End - Start
+					);
+					lines.Add(FString::ConstructFromPtrSize(utf8.Get(), utf8.Length()));
 				}
-				return "";
 			};
 
-			for(auto line = read_line();
-					!line.IsEmpty() || FPlatformProcess::IsProcRunning(proc_handle);
-					line = read_line()) {
-				if(line.IsEmpty()) {
+			auto split_lines = [&] {
+				auto line_start = int32{0};
+				for(auto i = 0; pending.Num() > i; ++i) {
+					if(pending[i] == '\n') {
+						add_line(line_start, i);
+						line_start = i + 1;
+					}
+				}
+				pending.RemoveAt(0, line_start, EAllowShrinking::No);
+				batcher->Push(lines);
+			};
+
+			auto terminated = false;
+			for(;;) {
+				// Checked before reading so output written right before exit is
+				// still drained
+				auto proc_running = FPlatformProcess::IsProcRunning(proc_handle);
+
+				if(proc_running && !terminated && CancelFlag && CancelFlag->load()) {
+					FPlatformProcess::TerminateProc(proc_handle, true);
+					terminated = true;
+				}
+
+				chunk.Reset();
+				FPlatformProcess::ReadPipeToArray(PipeReadParent, chunk);
+				if(!chunk.IsEmpty()) {
+					pending.Append(chunk);
+					split_lines();
 					continue;
 				}
 
-				AsyncTask(ENamedThreads::GameThread, [=] {
-					OnReceiveLine.Execute(line);
-				});
+				if(!proc_running) {
+					break;
+				}
+
+				FPlatformProcess::Sleep(idle_pipe_wait_seconds);
 			}
 
+			add_line(0, pending.Num());
+			batcher->Push(lines);
+
 			auto exit_code = int32{};
 			FPlatformProcess::GetProcReturnCode(proc_handle, &exit_code);
 
@@ -213,6 +408,7 @@ auto FEcsactEditorModule::SpawnEcsactCli(
 			FPlatformProcess::CloseProc(proc_handle);
 
 			AsyncTask(ENamedThreads::GameThread, [=, OnExit = std::move(OnExit)] {
+				batcher->Flush();
 				OnExit.Execute(exit_code);
 			});
 		}
@@ -301,6 +497,13 @@ auto FEcsactEditorModule::ShutdownModule() -> void {
 	);
 	SourcesWatchHandle = {};
 	FEditorDelegates::OnEditorInitialized.RemoveAll(this);
+
+	FTSTicker::RemoveTicker(BuildDebounceHandle);
+	BuildDebounceHandle.Reset();
+	bBuildQueued = false;
+	if(RunningBuildCancel) {
+		*RunningBuildCancel = true;
+	}
 }
 
 auto FEcsactEditorModule::LoadRunnerSubsystemBlueprints() -> void {
@@ -443,7 +646,7 @@ auto FEcsactEditorModule::AddMenuEntry(FMenuBuilder& MenuBuilder) -> void {
 				"not necessary to run manually from the menu."
 			),
 			FSlateIcon(),
-			FUIAction(FExecuteAction::CreateLambda([this] { RunBuild(); }))
+			FUIAction(FExecuteAction::CreateLambda([this] { RunBuild(true); }))
 		);
 	}
 	MenuBuilder.EndSection();
@@ -452,41 +655,60 @@ auto FEcsactEditorModule::AddMenuEntry(FMenuBuilder& MenuBuilder) -> void {
 auto FEcsactEditorModule::OnProjectSourcesChanged(
 	const TArray<FFileChangeData>& FileChanges
 ) -> void {
-	auto any_ecsact_files_changed = false;
-	for(auto& change : FileChanges) {
-		if(!change.Filename.EndsWith(".ecsact")) {
-			continue;
-		}
-
-		any_ecsact_files_changed = true;
-	}
+	auto& file_index = GetEcsactFileIndex();
+	auto  any_ecsact_files_changed = file_index.ApplyChanges(FileChanges);
 
 	if(any_ecsact_files_changed) {
+		file_index.Save();
+
 		UE_LOG(
 			EcsactEditor,
 			Log,
 			TEXT("Ecsact files changed. Rebuilding runtime ...")
 		);
 
-		RunBuild();
+		ScheduleBuild();
 	}
 }
 
-auto FEcsactEditorModule::RunBuild() -> void {
+auto FEcsactEditorModule::ScheduleBuild() -> void {
+	FTSTicker::RemoveTicker(BuildDebounceHandle);
+	BuildDebounceHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateLambda([this](float) -> bool {
+			BuildDebounceHandle.Reset();
+			RunBuild();
+			return false;
+		}),
+		BuildDebounceSeconds
+	);
+}
+
+auto FEcsactEditorModule::RunBuild(bool bForce) -> void {
 	const auto* settings = GetDefault<UEcsactSettings>();
 
 	if(!settings->bEnableBuild) {
 		return;
 	}
 
+	if(RunningBuildCancel) {
+		// The running build is already out of date. It is cancelled and the
+		// queued build starts once it has exited so builds never race on the
+		// same output.
+		bBuildQueued = true;
+		bQueuedBuildForced |= bForce;
+		*RunningBuildCancel = true;
+		return;
+	}
+
 	auto ecsact_runtime_path = settings->GetEcsactRuntimeLibraryPath();
-	auto temp_dir = FPaths::ConvertRelativePathToFull(FPaths::Combine(
-		FPaths::ProjectIntermediateDir(),
-		"Temp",
-		FPaths::CreateTempFilename(TEXT("EcsactBuild"))
-	));
+	auto staged_runtime_path = FPaths::Combine(
+		BuildCacheDir(),
+		FPaths::GetCleanFilename(ecsact_runtime_path)
+	);
+	auto temp_dir = FPaths::Combine(BuildCacheDir(), TEXT("Temp"));
 	auto recipes = settings->GetValidRecipes();
 	auto ecsact_files = GetAllEcsactFiles();
+	ecsact_files.Sort();
 
 	if(ecsact_files.IsEmpty()) {
 		UE_LOG(
@@ -508,11 +730,27 @@ auto FEcsactEditorModule::RunBuild() -> void {
 		return;
 	}
 
+	auto build_hash = GetBuildHash(ecsact_files, recipes, ecsact_runtime_path);
+	if(!bForce && FPaths::FileExists(ecsact_runtime_path)) {
+		auto prev_build_hash = FString{};
+		FFileHelper::LoadFileToString(prev_build_hash, *BuildHashPath());
+		if(prev_build_hash == build_hash) {
+			UE_LOG(EcsactEditor, Log, TEXT("Ecsact runtime is up to date"));
+			return;
+		}
+	}
+
+	// A failed or interrupted build must not look up to date next time
+	IFileManager::Get().Delete(*BuildHashPath(), false, false, true);
+	IFileManager::Get().Delete(*staged_runtime_path, false, false, true);
+
+	// Build next to the cache and move the result into place on success so a
+	// failed or cancelled build never leaves a partial runtime library behind
 	auto args = TArray<FString>{
 		"build",
 		"--format=json",
 		"-o",
-		ecsact_runtime_path,
+		staged_runtime_path,
 		"--temp=" + temp_dir,
 		"--debug",
 	};
@@ -534,23 +772,53 @@ auto FEcsactEditorModule::RunBuild() -> void {
 
 	args.Append(ecsact_files);
 
+	auto cancel_flag = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+	RunningBuildCancel = cancel_flag;
+
 	SpawnEcsactCli(
 		args,
 		FOnReceiveLine::CreateLambda([this](FString Line) {
 			OnReceiveEcsactCliJsonMessage(Line);
 		}),
-		FOnExitDelegate::CreateLambda([](int32 ExitCode) -> void {
-			if(ExitCode == 0) {
-				UE_LOG(EcsactEditor, Log, TEXT("Ecsact build success"));
-			} else {
-				UE_LOG(
-					EcsactEditor,
-					Error,
-					TEXT("Ecsact build failed with exit code %i"),
-					ExitCode
-				);
+		FOnExitDelegate::CreateLambda(
+			[=, this](int32 ExitCode) -> void {
+				RunningBuildCancel.Reset();
+
+				if(cancel_flag->load()) {
+					UE_LOG(EcsactEditor, Log, TEXT("Ecsact build cancelled"));
+				} else if(ExitCode != 0) {
+					UE_LOG(
+						EcsactEditor,
+						Error,
+						TEXT("Ecsact build failed with exit code %i"),
+						ExitCode
+					);
+				} else if(!MoveStagedFile(staged_runtime_path, ecsact_runtime_path)) {
+					UE_LOG(
+						EcsactEditor,
+						Error,
+						TEXT("Ecsact build succeeded but %s could not be replaced"),
+						*ecsact_runtime_path
+					);
+				} else {
+					UE_LOG(EcsactEditor, Log, TEXT("Ecsact build success"));
+					FFileHelper::SaveStringToFile(build_hash, *BuildHashPath());
+
+					const auto* settings = GetDefault<UEcsactSettings>();
+					if(settings->bHotReloadRuntime && GEditor && GEditor->PlayWorld) {
+						EcsactUnreal::ReloadRuntime();
+					}
+				}
+
+				if(bBuildQueued) {
+					auto force = bQueuedBuildForced;
+					bBuildQueued = false;
+					bQueuedBuildForced = false;
+					RunBuild(force);
+				}
 			}
-		})
+		),
+		cancel_flag
 	);
 }
 
@@ -691,11 +959,17 @@ auto FEcsactEditorModule::Get() -> FEcsactEditorModule& {
 	);
 }
 
+auto FEcsactEditorModule::GetEcsactFileIndex() -> FEcsactFileIndex& {
+	if(!EcsactFileIndex) {
+		EcsactFileIndex = MakeShared<FEcsactFileIndex>(SourceDir());
+		EcsactFileIndex->Refresh();
+		EcsactFileIndex->Save();
+	}
+	return *EcsactFileIndex;
+}
+
 auto FEcsactEditorModule::GetAllEcsactFiles() -> TArray<FString> {
-	auto& fm = FPlatformFileManager::Get().GetPlatformFile();
-	auto  files = TArray<FString>{};
-	fm.FindFilesRecursively(files, *SourceDir(), TEXT(".ecsact"));
-	return files;
+	return Get().GetEcsactFileIndex().GetFiles();
 }
 
 #undef LOCTEXT_NAMESPACE
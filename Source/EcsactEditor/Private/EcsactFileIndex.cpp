@@ -0,0 +1,209 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#include "EcsactFileIndex.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "IDirectoryWatcher.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static auto ToUnixMilliseconds(const FDateTime& Time) -> int64 {
+	return (Time - FDateTime{1970, 1, 1}).GetTicks() /
+		ETimespan::TicksPerMillisecond;
+}
+
+static auto GetModificationTime(const FString& Path) -> int64 {
+	auto stat = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*Path);
+	if(!stat.bIsValid) {
+		return -1;
+	}
+	return ToUnixMilliseconds(stat.ModificationTime);
+}
+
+static auto IsEcsactFile(const FString& Path) -> bool {
+	return Path.EndsWith(TEXT(".ecsact"));
+}
+
+FEcsactFileIndex::FEcsactFileIndex(FString InRootDir)
+	: RootDir(FPaths::ConvertRelativePathToFull(InRootDir)) {
+	FPaths::NormalizeDirectoryName(RootDir);
+}
+
+auto FEcsactFileIndex::GetIndexPath() -> FString {
+	return FPaths::ConvertRelativePathToFull(FPaths::Combine(
+		FPaths::ProjectIntermediateDir(),
+		TEXT("Ecsact"),
+		TEXT("EcsactFileIndex.txt")
+	));
+}
+
+auto FEcsactFileIndex::ListDirectory(
+	const FString&   Dir,
+	TArray<FString>& OutSubdirs
+) -> void {
+	auto& platform_file = FPlatformFileManager::Get().GetPlatformFile();
+	platform_file.IterateDirectoryStat(
+		*Dir,
+		[&](const TCHAR* Path, const FFileStatData& Stat) -> bool {
+			if(Stat.bIsDirectory) {
+				OutSubdirs.Add(Path);
+			} else if(IsEcsactFile(Path)) {
+				Files.Add(Path, ToUnixMilliseconds(Stat.ModificationTime));
+			}
+			return true;
+		}
+	);
+}
+
+auto FEcsactFileIndex::Refresh() -> void {
+	auto prev_files = TMap<FString, TArray<TPair<FString, int64>>>{};
+	auto prev_dirs = TMap<FString, int64>{};
+	auto prev_subdirs = TMap<FString, TArray<FString>>{};
+
+	auto lines = TArray<FString>{};
+	FFileHelper::LoadFileToStringArray(lines, *GetIndexPath());
+	auto header = FString::Printf(TEXT("ecsact-file-index %i"), Version);
+	if(!lines.IsEmpty() && lines[0] == header) {
+		for(auto i = 1; lines.Num() > i; ++i) {
+			auto kind = FString{};
+			auto rest = FString{};
+			auto mtime = FString{};
+			auto path = FString{};
+			if(!lines[i].Split(TEXT(" "), &kind, &rest)) {
+				continue;
+			}
+			if(!rest.Split(TEXT(" "), &mtime, &path)) {
+				continue;
+			}
+
+			auto parent = FPaths::GetPath(path);
+			if(kind == TEXT("d")) {
+				prev_dirs.Add(path, FCString::Atoi64(*mtime));
+				prev_subdirs.FindOrAdd(parent).Add(path);
+			} else if(kind == TEXT("f")) {
+				prev_files.FindOrAdd(parent).Emplace(path, FCString::Atoi64(*mtime));
+			}
+		}
+	}
+
+	Files.Empty();
+	Directories.Empty();
+
+	auto pending_dirs = TArray<FString>{RootDir};
+	while(!pending_dirs.IsEmpty()) {
+		auto dir = pending_dirs.Pop(EAllowShrinking::No);
+		auto dir_mtime = GetModificationTime(dir);
+		if(dir_mtime < 0) {
+			continue;
+		}
+
+		Directories.Add(dir, dir_mtime);
+
+		const auto* prev_dir_mtime = prev_dirs.Find(dir);
+		if(!prev_dir_mtime || *prev_dir_mtime != dir_mtime) {
+			ListDirectory(dir, pending_dirs);
+			continue;
+		}
+
+		// Same entries as last time. Only file contents may have changed.
+		if(const auto* files = prev_files.Find(dir)) {
+			for(const auto& file : *files) {
+				auto file_mtime = GetModificationTime(file.Key);
+				if(file_mtime >= 0) {
+					Files.Add(file.Key, file_mtime);
+				}
+			}
+		}
+		if(const auto* subdirs = prev_subdirs.Find(dir)) {
+			pending_dirs.Append(*subdirs);
+		}
+	}
+}
+
+auto FEcsactFileIndex::ApplyChanges( //
+	const TArray<FFileChangeData>& Changes
+) -> bool {
+	// Directory entries are left alone. Their stale modification time makes
+	// the next Refresh() list them again which also records new directories.
+	auto any_ecsact_files_changed = false;
+	for(const auto& change : Changes) {
+		auto path = FPaths::ConvertRelativePathToFull(change.Filename);
+
+		if(change.Action == FFileChangeData::FCA_RescanRequired) {
+			Refresh();
+			return true;
+		}
+
+		if(!IsEcsactFile(path)) {
+			if(change.Action == FFileChangeData::FCA_Added) {
+				// May be a directory moved or copied in with .ecsact files inside
+				auto added_count = Files.Num();
+				auto pending_dirs = TArray<FString>{};
+				if(FPaths::DirectoryExists(path)) {
+					pending_dirs.Add(path);
+				}
+				while(!pending_dirs.IsEmpty()) {
+					ListDirectory(pending_dirs.Pop(EAllowShrinking::No), pending_dirs);
+				}
+				any_ecsact_files_changed |= added_count != Files.Num();
+			} else if(change.Action == FFileChangeData::FCA_Removed) {
+				// May have been a directory containing .ecsact files
+				auto dir_prefix = path + TEXT("/");
+				auto removed_count = Files.Num();
+				for(auto itr = Files.CreateIterator(); itr; ++itr) {
+					if(itr.Key().StartsWith(dir_prefix)) {
+						itr.RemoveCurrent();
+					}
+				}
+				any_ecsact_files_changed |= removed_count != Files.Num();
+			}
+			continue;
+		}
+
+		any_ecsact_files_changed = true;
+		auto mtime = GetModificationTime(path);
+		if(change.Action == FFileChangeData::FCA_Removed || mtime < 0) {
+			Files.Remove(path);
+		} else {
+			Files.Add(path, mtime);
+		}
+	}
+
+	return any_ecsact_files_changed;
+}
+
+auto FEcsactFileIndex::Save() const -> bool {
+	auto lines = TArray<FString>{};
+	lines.Reserve(1 + Directories.Num() + Files.Num());
+	lines.Add(FString::Printf(TEXT("ecsact-file-index %i"), Version));
+	for(const auto& entry : Directories) {
+		lines.Add(FString::Printf(TEXT("d %lld %s"), entry.Value, *entry.Key));
+	}
+	for(const auto& entry : Files) {
+		lines.Add(FString::Printf(TEXT("f %lld %s"), entry.Value, *entry.Key));
+	}
+
+	// Written to a temporary file first so the codegen tool never reads a
+	// partially written index
+	auto index_path = GetIndexPath();
+	auto temp_path = index_path + TEXT(".tmp");
+	auto saved = FFileHelper::SaveStringArrayToFile(
+		lines,
+		*temp_path,
+		FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM
+	);
+	if(!saved) {
+		return false;
+	}
+	return IFileManager::Get().Move(*index_path, *temp_path, true, true);
+}
+
+auto FEcsactFileIndex::GetFiles() const -> TArray<FString> {
+	auto files = TArray<FString>{};
+	Files.GetKeys(files);
+	return files;
+}
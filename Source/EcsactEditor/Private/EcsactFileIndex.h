@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Persistent index of the .ecsact files under a directory. The index is
+ * stored in Intermediate/Ecsact/EcsactFileIndex.txt and is also read and
+ * updated by the EcsactUnrealCodegen tool.
+ *
+ * File layout (one entry per line, times are unix milliseconds):
+ *
+ *   ecsact-file-index 1
+ *   d <mtime> <absolute directory path>
+ *   f <mtime> <absolute .ecsact file path>
+ *
+ * Every directory under the root is listed. A directory whose modification
+ * time is unchanged has the same entries so only changed directories are
+ * listed again on Refresh().
+ */
+class FEcsactFileIndex {
+	FString              RootDir;
+	TMap<FString, int64> Files;
+	TMap<FString, int64> Directories;
+
+	auto ListDirectory(const FString& Dir, TArray<FString>& OutSubdirs) -> void;
+
+public:
+	static constexpr auto Version = 1;
+
+	explicit FEcsactFileIndex(FString InRootDir);
+
+	static auto GetIndexPath() -> FString;
+
+	/**
+	 * Loads the index file and lists again only the directories that changed
+	 * since it was written. Lists everything if there is no usable index.
+	 */
+	auto Refresh() -> void;
+
+	/**
+	 * Applies directory watcher changes. Returns true if any .ecsact file was
+	 * added, removed or modified.
+	 */
+	auto ApplyChanges(const TArray<struct FFileChangeData>& Changes) -> bool;
+
+	auto Save() const -> bool;
+
+	auto GetFiles() const -> TArray<FString>;
+};
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <atomic>
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "EcsactUnreal/Ecsact.h"
 #include "Modules/ModuleManager.h"
 #include "HAL/PlatformFileManager.h"
@@ -16,10 +18,19 @@ DECLARE_LOG_CATEGORY_EXTERN(EcsactEditor, Log, All);
 
 class ECSACTEDITOR_API FEcsactEditorModule : public IModuleInterface {
 	FDelegateHandle SourcesWatchHandle;
+	FString         EcsactSdkVersion;
 
 public:
 	using FOnExitDelegate = TDelegate<void(int32)>;
 	using FOnReceiveLine = TDelegate<void(FString)>;
+	using FCancelFlag = TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe>;
+
+private:
+	FTSTicker::FDelegateHandle         BuildDebounceHandle;
+	FCancelFlag                        RunningBuildCancel;
+	bool                               bBuildQueued = false;
+	bool                               bQueuedBuildForced = false;
+	TSharedPtr<class FEcsactFileIndex> EcsactFileIndex;
 
 private:
 	auto OnEditorInitialized(double Duration) -> void;
@@ -33,6 +44,13 @@ private:
 	auto OnReceiveEcsactCliJsonMessage(FString Json) -> void;
 	auto AddMenuEntry(class FMenuBuilder& MenuBuilder) -> void;
 	auto LoadRunnerSubsystemBlueprints() -> void;
+	auto GetEcsactFileIndex() -> class FEcsactFileIndex&;
+
+	/**
+	 * Runs a build once .ecsact file changes have settled. Repeated calls
+	 * restart the wait.
+	 */
+	auto ScheduleBuild() -> void;
 
 	auto OnAssetsAdded(TConstArrayView<FAssetData> Assets) -> void;
 	auto OnAssetsUpdatedOnDisk(TConstArrayView<FAssetData> Assets) -> void;
@@ -40,19 +58,43 @@ private:
 	auto OnAssetRegistryFilesLoaded() -> void;
 	auto GetInstalledPluginDir() -> FString;
 	auto GetEcsactSdkBinaryPath(FString BinaryName) -> FString;
+	auto GetEcsactSdkVersion() -> FString;
+	auto GetBuildHash(
+		const TArray<FString>& EcsactFiles,
+		const TArray<FString>& Recipes,
+		const FString&         RuntimePath
+	) -> FString;
 
 public:
 	auto GetEcsactCli() -> FString;
 
+	/**
+	 * Runs the ecsact CLI in the background. Setting @p CancelFlag terminates
+	 * the process. @p OnExit is still called afterwards.
+	 */
 	auto SpawnEcsactCli( //
 		const TArray<FString>& Args,
 		FOnReceiveLine         OnReceiveLine,
-		FOnExitDelegate        OnExit
+		FOnExitDelegate        OnExit,
+		FCancelFlag            CancelFlag = {}
 	) -> void;
 
+	/**
+	 * All .ecsact files in the project Source directory. Served from a
+	 * persistent index that is kept up to date by the directory watcher.
+	 */
 	static auto GetAllEcsactFiles() -> TArray<FString>;
 
-	auto RunBuild() -> void;
+	/**
+	 * Builds the ecsact runtime with the configured recipes. The build is
+	 * skipped if the .ecsact files, recipes, SDK version and output path are
+	 * unchanged since the last successful build unless @p bForce is set.
+	 *
+	 * Only one build runs at a time. Calling this during a build cancels it
+	 * and queues another build. The runtime library is only replaced when a
+	 * build succeeds.
+	 */
+	auto RunBuild(bool bForce = false) -> void;
 
 	auto StartupModule() -> void override;
 	auto ShutdownModule() -> void override;
@@ -5,9 +5,13 @@
 // online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
 
 #include <format>
+#include <algorithm>
 #include <array>
+#include <cstdlib>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "ecsact/runtime/meta.hh"
 #include "ecsact/codegen/plugin.hh"
 #include "ecsact/lang-support/lang-cc.hh"
@@ -25,6 +29,57 @@ constexpr int32_t GENERATED_HEADER_INDEX = 0;
 constexpr int32_t GENERATED_SOURCE_INDEX = 1;
 constexpr int32_t GENERATED_MASS_HEADER_INDEX = 2;
 constexpr int32_t GENERATED_MASS_SOURCE_INDEX = 3;
+// Additional source shards follow the fixed outputs. See source_shard_count.
+constexpr int32_t GENERATED_SHARDS_INDEX = 4;
+
+/**
+ * Components per generated .cpp file. Set with the
+ * ECSACT_UNREAL_CODEGEN_COMPONENTS_PER_SOURCE environment variable which the
+ * EcsactUnrealCodegen tool sets from --components-per-source. 0 generates one
+ * source and one mass source per package.
+ */
+static auto components_per_source() -> size_t {
+	static const auto value = [] {
+		auto env = std::getenv("ECSACT_UNREAL_CODEGEN_COMPONENTS_PER_SOURCE");
+		if(!env) {
+			return size_t{0};
+		}
+		auto parsed = std::strtoll(env, nullptr, 10);
+		return parsed > 0 ? static_cast<size_t>(parsed) : size_t{0};
+	}();
+	return value;
+}
+
+/**
+ * Number of .cpp files the package source and mass source are each split
+ * into. Shard 0 is the regular __ecsact__ue.cpp / __ecsact__mass__ue.cpp.
+ */
+static auto source_shard_count(ecsact_package_id package_id) -> int32_t {
+	auto per_source = components_per_source();
+	auto comp_count = ecsact::meta::get_component_ids(package_id).size();
+	if(per_source == 0 || comp_count <= per_source) {
+		return 1;
+	}
+	return static_cast<int32_t>((comp_count + per_source - 1) / per_source);
+}
+
+/**
+ * Components whose definitions go in source shard @p shard.
+ */
+static auto shard_component_ids( //
+	ecsact_package_id package_id,
+	int32_t           shard
+) -> std::vector<ecsact_component_id> {
+	auto comp_ids = ecsact::meta::get_component_ids(package_id);
+	auto per_source = components_per_source();
+	if(per_source == 0) {
+		return comp_ids;
+	}
+
+	auto begin = std::min(comp_ids.size(), shard * per_source);
+	auto end = std::min(comp_ids.size(), begin + per_source);
+	return {comp_ids.begin() + begin, comp_ids.begin() + end};
+}
 
 inline auto inc_package_header_no_ext( //
 	ecsact::codegen_plugin_context& ctx,
@@ -85,13 +140,28 @@ auto ecsact_codegen_output_filenames( //
 			.filename()
 			.replace_extension("")
 			.string();
+	auto filenames = std::vector{
+		pkg_basename + "__ecsact__ue.h"s, // GENERATED_HEADER_INDEX
+		pkg_basename + "__ecsact__ue.cpp"s, // GENERATED_SOURCE_INDEX
+		pkg_basename + "__ecsact__mass__ue.h"s, // GENERATED_MASS_HEADER_INDEX
+		pkg_basename + "__ecsact__mass__ue.cpp"s, // GENERATED_MASS_SOURCE_INDEX
+	};
+
+	// GENERATED_SHARDS_INDEX onward: source shards then mass source shards
+	auto shard_count = source_shard_count(package_id);
+	for(auto shard = 1; shard_count > shard; ++shard) {
+		filenames.push_back( //
+			std::format("{}__ecsact__ue_{}.cpp", pkg_basename, shard)
+		);
+	}
+	for(auto shard = 1; shard_count > shard; ++shard) {
+		filenames.push_back(
+			std::format("{}__ecsact__mass__ue_{}.cpp", pkg_basename, shard)
+		);
+	}
+
 	ecsact::set_codegen_plugin_output_filenames(
-		std::array{
-			pkg_basename + "__ecsact__ue.h"s, // GENERATED_HEADER_INDEX
-			pkg_basename + "__ecsact__ue.cpp"s, // GENERATED_SOURCE_INDEX
-			pkg_basename + "__ecsact__mass__ue.h"s, // GENERATED_MASS_HEADER_INDEX
-			pkg_basename + "__ecsact__mass__ue.cpp"s, // GENERATED_MASS_SOURCE_INDEX
-		},
+		filenames,
 		out_filenames,
 		max_filenames,
 		max_filename_length,
@@ -121,7 +191,7 @@ static auto ecsact_type_to_unreal_type(
 		case ECSACT_F32:
 			return "float";
 		case ECSACT_ENTITY_TYPE:
-			break;
+			return "int32";
 		default:
 			ctx.fatal(
 				"Ecsact Unreal codegen plugin unknown builtin type ({}). Cannot "
@@ -159,20 +229,94 @@ static auto print_ue_warning(
 	ctx.writef("UE_LOG(Ecsact, Warning, TEXT(\"{}\"), {}, {});\n", text, v1, v2);
 }
 
+/**
+ * Element type of an array field. Blueprints can't use static arrays so the
+ * element matches the Ecsact storage exactly and the array is copied with a
+ * single memcpy. UHT rejects static bool arrays so they are stored as uint8.
+ */
+static auto ecsact_array_element_unreal_type(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_builtin_type             type
+) -> std::string {
+	switch(type) {
+		case ECSACT_BOOL:
+			static_assert(sizeof(bool) == sizeof(uint8_t));
+			return "uint8";
+		case ECSACT_I8:
+			return "int8";
+		case ECSACT_U8:
+			return "uint8";
+		case ECSACT_I16:
+			return "int16";
+		case ECSACT_U16:
+			return "uint16";
+		default:
+			return ecsact_type_to_unreal_type(ctx, type);
+	}
+}
+
+/**
+ * Package that declares @p enum_id. Enums may come from an imported package.
+ */
+static auto ecsact_enum_package_id(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_enum_id                  enum_id
+) -> ecsact_package_id {
+	auto package_ids = ecsact::meta::get_dependencies(ctx.package_id);
+	package_ids.insert(package_ids.begin(), ctx.package_id);
+	for(auto package_id : package_ids) {
+		for(auto id : ecsact::meta::get_enum_ids(package_id)) {
+			if(id == enum_id) {
+				return package_id;
+			}
+		}
+	}
+	return ctx.package_id;
+}
+
+static auto ecsact_uenum_name(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_enum_id                  enum_id
+) -> std::string {
+	auto package_name =
+		ecsact::meta::package_name(ecsact_enum_package_id(ctx, enum_id));
+	return std::format(
+		"E{}",
+		ecsact_decl_name_to_pascal(
+			package_name + "." + ecsact::meta::enum_name(enum_id)
+		)
+	);
+}
+
+/**
+ * Blueprints only support uint8 enums. Ecsact enums with values outside that
+ * range are generated as int32 enums usable from C++ only.
+ */
+static auto ecsact_enum_blueprint_compatible(ecsact_enum_id enum_id) -> bool {
+	for(const auto& enum_value : ecsact::meta::get_enum_values(enum_id)) {
+		if(enum_value.value < 0 || enum_value.value > 255) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Unreal type of a single element of @p type. Array fields are declared as
+ * static arrays of this type.
+ */
 static auto ecsact_type_to_unreal_type(
 	ecsact::codegen_plugin_context& ctx,
 	ecsact_field_type               type
 ) -> std::string {
 	switch(type.kind) {
 		case ECSACT_TYPE_KIND_BUILTIN:
-			if(type.length == 1) {
-				return ecsact_type_to_unreal_type(ctx, type.type.builtin);
+			if(type.length > 1) {
+				return ecsact_array_element_unreal_type(ctx, type.type.builtin);
 			}
-			ctx.fatal("Ecsact builtin array fields not supported yet");
-			break;
+			return ecsact_type_to_unreal_type(ctx, type.type.builtin);
 		case ECSACT_TYPE_KIND_ENUM:
-			ctx.fatal("Esact enum type not supported in yet");
-			break;
+			return ecsact_uenum_name(ctx, type.type.enum_id);
 		case ECSACT_TYPE_KIND_FIELD_INDEX:
 			ctx.fatal("Ecsact field index not supported in unreal yet");
 			break;
@@ -189,6 +333,12 @@ static auto ecsact_type_to_unreal_type(
 	return "";
 }
 
+static auto package_pascal_to_component_mirror( //
+	std::string package_pascal_name
+) {
+	return std::format("U{}EcsactComponentMirror", package_pascal_name);
+}
+
 static auto package_pascal_to_mass_spawner(std::string package_pascal_name) {
 	return std::format("U{}MassSpawner", package_pascal_name);
 }
@@ -204,6 +354,17 @@ static auto to_comp_fragment_name(
 	return std::format("F{}{}Fragment", package_pascal_name, comp_pascal_name);
 }
 
+static auto to_comp_mass_processor_name(
+	std::string package_pascal_name,
+	std::string comp_pascal_name
+) {
+	return std::format(
+		"U{}{}MassProcessor",
+		package_pascal_name,
+		comp_pascal_name
+	);
+}
+
 static auto ecsact_ustruct_name(auto decl_id) -> std::string {
 	auto name = ecsact::meta::decl_full_name(decl_id);
 	auto pascal_name = ecsact_decl_name_to_pascal(name);
@@ -223,6 +384,18 @@ static auto print_ecsact_type_uproperty(
 	ecsact::codegen_plugin_context& ctx,
 	ecsact_field_type               field_type
 ) -> void {
+	// Static arrays and non uint8 enums can't be exposed to blueprints
+	auto blueprint_compatible = field_type.length <= 1;
+	if(field_type.kind == ECSACT_TYPE_KIND_ENUM) {
+		blueprint_compatible = blueprint_compatible &&
+			ecsact_enum_blueprint_compatible(field_type.type.enum_id);
+	}
+
+	if(!blueprint_compatible) {
+		ctx.write("UPROPERTY(EditAnywhere)\n");
+		return;
+	}
+
 	ctx.write("UPROPERTY(EditAnywhere, BlueprintReadWrite");
 	switch(field_type.kind) {
 		case ECSACT_TYPE_KIND_BUILTIN:
@@ -260,6 +433,83 @@ static auto print_ecsact_type_uproperty(
 	ctx.write(")\n");
 }
 
+/**
+ * Copies an Ecsact component field from `component` into `result`. Array
+ * elements are laid out identically so they are copied with one memcpy.
+ */
+static auto print_field_copy(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_field_type               field_type,
+	std::string_view                field_unreal_type,
+	std::string_view                field_pascal_name,
+	std::string_view                field_name
+) -> void {
+	if(field_type.length <= 1) {
+		ctx.writef(
+			"result.{} = static_cast<{}>(component->{});\n",
+			field_pascal_name,
+			field_unreal_type,
+			field_name
+		);
+		return;
+	}
+
+	if(field_type.kind == ECSACT_TYPE_KIND_ENUM) {
+		// Blueprint enums are uint8 regardless of the Ecsact storage type
+		block(
+			ctx,
+			std::format("for(auto i = 0; {} > i; ++i)", field_type.length),
+			[&] {
+				ctx.writef(
+					"result.{}[i] = static_cast<{}>(component->{}[i]);\n",
+					field_pascal_name,
+					field_unreal_type,
+					field_name
+				);
+			}
+		);
+		ctx.writef("\n");
+		return;
+	}
+
+	ctx.writef(
+		"static_assert(sizeof(result.{0}) == sizeof(component->{1}));\n"
+		"FMemory::Memcpy(result.{0}, &component->{1}, sizeof(result.{0}));\n",
+		field_pascal_name,
+		field_name
+	);
+}
+
+static auto print_uenum(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_enum_id                  enum_id
+) -> void {
+	auto blueprint_compatible = ecsact_enum_blueprint_compatible(enum_id);
+
+	ctx.writef(
+		"\nUENUM({})\n",
+		blueprint_compatible ? "BlueprintType" : ""
+	);
+	block(
+		ctx,
+		std::format(
+			"enum class {} : {}",
+			ecsact_uenum_name(ctx, enum_id),
+			blueprint_compatible ? "uint8" : "int32"
+		),
+		[&] {
+			for(const auto& enum_value : ecsact::meta::get_enum_values(enum_id)) {
+				ctx.writef(
+					"{} = {},\n",
+					ecsact_decl_name_to_pascal(enum_value.name),
+					enum_value.value
+				);
+			}
+		}
+	);
+	ctx.writef(";\n");
+}
+
 static auto print_ustruct(ecsact::codegen_plugin_context& ctx, auto in_compo_id)
 	-> void {
 	auto compo_id = ecsact_id_cast<ecsact_composite_id>(in_compo_id);
@@ -283,12 +533,92 @@ static auto print_ustruct(ecsact::codegen_plugin_context& ctx, auto in_compo_id)
 			auto field_pascal_name = ecsact_decl_name_to_pascal(field_name);
 
 			print_ecsact_type_uproperty(ctx, field_type);
-			ctx.write(std::format("{} {};\n", field_unreal_type, field_pascal_name));
+			if(field_type.length > 1) {
+				ctx.writef(
+					"{} {}[{}];\n",
+					field_unreal_type,
+					field_pascal_name,
+					field_type.length
+				);
+			} else {
+				ctx.write(
+					std::format("{} {};\n", field_unreal_type, field_pascal_name)
+				);
+			}
 		}
 	});
 	ctx.writef(";\n\n");
 }
 
+/**
+ * Same hash as EcsactUnreal::EcsactNameHash so generated tables can be
+ * searched with names hashed at compile time.
+ */
+static auto ecsact_name_hash(std::string_view name) -> uint32_t {
+	auto hash = uint32_t{2166136261u};
+	for(auto c : name) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= uint32_t{16777619u};
+	}
+	return hash;
+}
+
+static auto print_ecsact_unreal_component_meta( //
+	std::string_view                prefix,
+	ecsact::codegen_plugin_context& ctx
+) -> void {
+	auto comp_ids = ecsact::meta::get_component_ids(ctx.package_id);
+
+	auto max_comp_id = 0;
+	for(auto comp_id : comp_ids) {
+		max_comp_id = std::max(max_comp_id, static_cast<int>(comp_id));
+	}
+
+	ctx.writef(
+		"/** Largest component id in this package. For sizing id indexed "
+		"arrays. */\n"
+		"constexpr auto {}MaxComponentId = {};\n\n",
+		prefix,
+		max_comp_id
+	);
+
+	ctx.writef(
+		"constexpr auto {}Components = "
+		"std::array<EcsactUnreal::FEcsactComponentMeta, {}>{{{{\n",
+		prefix,
+		comp_ids.size()
+	);
+	for(auto comp_id : comp_ids) {
+		auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
+		auto comp_type_cpp_name = cpp_identifier(comp_full_name);
+		auto field_count = ecsact::meta::get_field_ids(comp_id).size();
+		auto is_tag = field_count == 0;
+
+		// Tag components are empty structs which the runtime never stores
+		ctx.writef(
+			"\t{{\n"
+			"\t\t.Id = static_cast<ecsact_component_id>({}),\n"
+			"\t\t.Size = {},\n"
+			"\t\t.Alignment = alignof({}),\n"
+			"\t\t.FieldCount = {},\n"
+			"\t\t.bTag = {},\n"
+			"\t\t.bTransient = {}::transient,\n"
+			"\t\t.NameHash = 0x{:08X}u,\n"
+			"\t\t.FullName = \"{}\",\n"
+			"\t}},\n",
+			static_cast<int>(comp_id),
+			is_tag ? "0"s : std::format("sizeof({})", comp_type_cpp_name),
+			comp_type_cpp_name,
+			field_count,
+			is_tag ? "true" : "false",
+			comp_type_cpp_name,
+			ecsact_name_hash(comp_full_name),
+			comp_full_name
+		);
+	}
+	ctx.writef("}}}};\n");
+}
+
 static auto print_ecsact_unreal_package_meta( //
 	std::string_view                prefix,
 	ecsact::codegen_plugin_context& ctx
@@ -318,75 +648,45 @@ static auto print_ecsact_unreal_package_meta( //
 	for(auto id : system_like_ids) {
 		ctx.writef("\t\"{}\",\n", c_identifier(ecsact::meta::decl_full_name(id)));
 	}
-	ctx.writef("}};\n");
-}
-
-static auto generate_header(ecsact::codegen_plugin_context ctx) -> void {
-	ctx.writef("#pragma once\n\n");
-
-	inc_header(ctx, "CoreMinimal.h");
-	inc_header(ctx, "UObject/Interface.h");
-	ctx.writef("#include <array>\n");
-	inc_header(ctx, "ecsact/runtime/common.h");
-	inc_header(ctx, "EcsactUnreal/Ecsact.h");
-	inc_header(ctx, "EcsactUnreal/EcsactRunnerSubsystem.h");
-	inc_package_header(ctx, ctx.package_id, ".hh");
-	inc_package_header_no_ext(ctx, ctx.package_id, "__ecsact__ue.generated.h");
-
-	auto package_pascal_name =
-		ecsact_decl_name_to_pascal(ecsact::meta::package_name(ctx.package_id));
-
-	ctx.writef("\n\n");
+	ctx.writef("}};\n\n");
 
-	block(ctx, "namespace EcsactUnreal::CodegenMeta", [&] {
-		print_ecsact_unreal_package_meta(package_pascal_name, ctx);
-	});
-	ctx.writef("\n\n");
+	print_ecsact_unreal_component_meta(prefix, ctx);
+}
 
-	for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
-		print_ustruct(ctx, comp_id);
-	}
+static auto print_component_mirror_header(
+	ecsact::codegen_plugin_context& ctx,
+	std::string                     package_pascal_name
+) -> void {
+	auto mirror_name = package_pascal_to_component_mirror(package_pascal_name);
+	auto comp_ids = ecsact::meta::get_component_ids(ctx.package_id);
 
 	ctx.write(std::format(
-		"\nUCLASS(Abstract, Blueprintable, meta = "
-		"(DisplayName = \"Ecsact Runner Package Subsystem ({})\"))\n",
+		"\n/**\n"
+		" * Mirrors every {} component into entity indexed sparse sets. Only\n"
+		" * created when UEcsactSettings::bEnableComponentMirrors is set.\n"
+		" */\n",
+		ecsact::meta::package_name(ctx.package_id)
+	));
+	ctx.write(std::format(
+		"UCLASS(meta = "
+		"(DisplayName = \"Ecsact Component Mirror ({})\"))\n",
 		ecsact::meta::package_name(ctx.package_id)
 	));
 	block(
 		ctx,
-		std::format(
-			"class U{}EcsactRunnerSubsystem : public UEcsactRunnerSubsystem",
-			package_pascal_name
-		),
+		std::format("class {} : public UEcsactRunnerSubsystem", mirror_name),
 		[&] {
 			ctx.writef("GENERATED_BODY() // NOLINT\n\n");
 
-			ctx.write(
-				"TArray<void(ThisClass::*)(int32, const void*)> InitComponentFns;\n"
-				"TArray<void(ThisClass::*)(int32, const void*)> UpdateComponentFns;\n"
-				"TArray<void(ThisClass::*)(int32, const void*)> RemoveComponentFns;\n"
-			);
-
-			for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
+			for(auto comp_id : comp_ids) {
 				auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
-				auto comp_type_cpp_name = cpp_identifier(comp_full_name);
 				auto comp_name = ecsact::meta::component_name(comp_id);
 				auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
-
-				ctx.write(std::format(
-					"void RawInit{0}(int32 Entity, const void* Component);\n",
-					comp_pascal_name
-				));
-
-				ctx.write(std::format(
-					"void RawUpdate{0}(int32 Entity, const void* Component);\n",
-					comp_pascal_name
-				));
-
-				ctx.write(std::format(
-					"void RawRemove{0}(int32 Entity, const void* Component);\n",
+				ctx.writef(
+					"TEcsactComponentSparseSet<{}> {}Set;\n",
+					cpp_identifier(comp_full_name),
 					comp_pascal_name
-				));
+				);
 			}
 
 			ctx.indentation -= 1;
@@ -401,7 +701,7 @@ static auto generate_header(ecsact::codegen_plugin_context ctx) -> void {
 				"void UpdateComponentRaw("
 				"ecsact_entity_id, ecsact_component_id, const void*) override;\n"
 				"void RemoveComponentRaw("
-				"ecsact_entity_id, ecsact_component_id, const void*) override;\n\n"
+				"ecsact_entity_id, ecsact_component_id, const void*) override;\n"
 			);
 
 			ctx.indentation -= 1;
@@ -411,58 +711,341 @@ static auto generate_header(ecsact::codegen_plugin_context ctx) -> void {
 			ctx.writef("\n");
 
 			ctx.write(
-				std::format("U{}EcsactRunnerSubsystem();\n", package_pascal_name)
+				"auto ShouldCreateSubsystem(UObject* Outer) const -> bool override;\n"
+				"auto RunnerStop_Implementation(class UEcsactRunner* Runner) -> void "
+				"override;\n"
+				"auto EntityDestroyed_Implementation(int32 Entity) -> void "
+				"override;\n\n"
 			);
 
-			for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
-				auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
-				auto comp_type_cpp_name = cpp_identifier(comp_full_name);
-				auto comp_name = ecsact::meta::component_name(comp_id);
-				auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
-				auto comp_ustruct_name = ecsact_ustruct_name(comp_id);
-				ctx.write(std::format(
-					"\nUFUNCTION(BlueprintNativeEvent, Category = \"Ecsact Runner\", "
-					"meta = (DisplayName = \"Init {}\"))\n",
-					comp_full_name
-				));
-				ctx.write(std::format(
-					"void Init{0}(int32 Entity, {1} {0});\n",
-					comp_pascal_name,
-					comp_ustruct_name
-				));
-				ctx.write(std::format(
-					"virtual void Init{0}_Implementation(int32 Entity, {1} {0});\n",
-					comp_pascal_name,
-					comp_ustruct_name
-				));
+			ctx.write("template<typename C>\n");
+			block(
+				ctx,
+				"auto GetSparseSet() const -> const TEcsactComponentSparseSet<C>&",
+				[&] {
+					for(auto comp_id : comp_ids) {
+						auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
+						auto comp_name = ecsact::meta::component_name(comp_id);
+						auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+						ctx.writef(
+							"if constexpr(std::is_same_v<C, {}>) {{\n"
+							"\treturn {}Set;\n"
+							"}} else ",
+							cpp_identifier(comp_full_name),
+							comp_pascal_name
+						);
+					}
+					ctx.writef(
+						"{{\n"
+						"\tstatic_assert(sizeof(C) == 0, "
+						"\"Component is not in package {}\");\n"
+						"}}",
+						ecsact::meta::package_name(ctx.package_id)
+					);
+				}
+			);
+			ctx.write("\n\n");
 
-				ctx.write(std::format(
-					"\nUFUNCTION(BlueprintNativeEvent, Category = \"Ecsact Runner\", "
-					"meta = (DisplayName = \"Update {}\"))\n",
-					comp_full_name
-				));
-				ctx.write(std::format(
-					"void Update{0}(int32 Entity, {1} {0});\n",
-					comp_pascal_name,
-					comp_ustruct_name
-				));
-				ctx.write(std::format(
-					"virtual void Update{0}_Implementation(int32 Entity, {1} {0});\n",
-					comp_pascal_name,
-					comp_ustruct_name
-				));
+			ctx.write("template<typename C>\n");
+			block(ctx, "auto Get(ecsact_entity_id Entity) const -> const C*", [&] {
+				ctx.write("return GetSparseSet<C>().Find(Entity);");
+			});
+			ctx.write("\n\n");
 
+			ctx.write("template<typename C>\n");
+			block(ctx, "auto Has(ecsact_entity_id Entity) const -> bool", [&] {
+				ctx.write("return GetSparseSet<C>().Contains(Entity);");
+			});
+			ctx.write("\n\n");
+
+			ctx.write(
+				"/**\n"
+				" * Calls Callback(Entity, const C&, const Cs&...) for every entity\n"
+				" * with all of the given components. Pass the rarest component "
+				"first.\n"
+				" */\n"
+			);
+			ctx.write("template<typename C, typename... Cs, typename Fn>\n");
+			block(ctx, "auto ForEach(Fn&& Callback) const -> void", [&] {
+				ctx.write(
+					"EcsactUnreal::ForEachComponents(\n"
+					"\tstd::forward<Fn>(Callback),\n"
+					"\tGetSparseSet<C>(),\n"
+					"\tGetSparseSet<Cs>()...\n"
+					");"
+				);
+			});
+			ctx.write("\n");
+		}
+	);
+	ctx.writef(";\n");
+}
+
+static auto print_component_mirror_raw_fn(
+	ecsact::codegen_plugin_context& ctx,
+	std::string_view                mirror_name,
+	std::string_view                event_name,
+	std::string_view                set_method,
+	bool                            with_data
+) -> void {
+	block(
+		ctx,
+		std::format(
+			"void {}::{}ComponentRaw"
+			"( ecsact_entity_id entity"
+			", ecsact_component_id component_id"
+			", const void* component_data)",
+			mirror_name,
+			event_name
+		),
+		[&] {
+			block(ctx, "switch(component_id)", [&] {
+				for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
+					auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
+					auto comp_type_cpp_name = cpp_identifier(comp_full_name);
+					auto comp_name = ecsact::meta::component_name(comp_id);
+					auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+					ctx.writef("case {}::id:\n", comp_type_cpp_name);
+					if(with_data && ecsact::meta::get_field_ids(comp_id).empty()) {
+						// Tag components may be given a null component_data
+						ctx.writef(
+							"\t{}Set.{}(entity, {}{{}});\n",
+							comp_pascal_name,
+							set_method,
+							comp_type_cpp_name
+						);
+					} else if(with_data) {
+						ctx.writef(
+							"\t{}Set.{}(entity, "
+							"*static_cast<const {}*>(component_data));\n",
+							comp_pascal_name,
+							set_method,
+							comp_type_cpp_name
+						);
+					} else {
+						ctx.writef("\t{}Set.{}(entity);\n", comp_pascal_name, set_method);
+					}
+					ctx.write("\tbreak;\n");
+				}
+				ctx.write("default:\n\tbreak;");
+			});
+		}
+	);
+	ctx.write("\n\n");
+}
+
+static auto print_component_mirror_source(
+	ecsact::codegen_plugin_context& ctx,
+	std::string                     package_pascal_name
+) -> void {
+	auto mirror_name = package_pascal_to_component_mirror(package_pascal_name);
+	auto comp_ids = ecsact::meta::get_component_ids(ctx.package_id);
+
+	block(
+		ctx,
+		std::format(
+			"auto {}::ShouldCreateSubsystem(UObject* Outer) const -> bool",
+			mirror_name
+		),
+		[&] {
+			ctx.write(
+				"return GetDefault<UEcsactSettings>()->bEnableComponentMirrors;"
+			);
+		}
+	);
+	ctx.write("\n\n");
+
+	print_component_mirror_raw_fn(ctx, mirror_name, "Init", "Set", true);
+	print_component_mirror_raw_fn(ctx, mirror_name, "Update", "Set", true);
+	print_component_mirror_raw_fn(ctx, mirror_name, "Remove", "Remove", false);
+
+	block(
+		ctx,
+		std::format(
+			"auto {}::RunnerStop_Implementation(UEcsactRunner* Runner) -> void",
+			mirror_name
+		),
+		[&] {
+			for(auto comp_id : comp_ids) {
+				auto comp_name = ecsact::meta::component_name(comp_id);
+				auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+				ctx.writef("{}Set.Reset();\n", comp_pascal_name);
+			}
+		}
+	);
+	ctx.write("\n\n");
+
+	block(
+		ctx,
+		std::format(
+			"auto {}::EntityDestroyed_Implementation(int32 Entity) -> void",
+			mirror_name
+		),
+		[&] {
+			ctx.write("auto entity = static_cast<ecsact_entity_id>(Entity);\n");
+			for(auto comp_id : comp_ids) {
+				auto comp_name = ecsact::meta::component_name(comp_id);
+				auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+				ctx.writef("{}Set.Remove(entity);\n", comp_pascal_name);
+			}
+		}
+	);
+	ctx.write("\n\n");
+}
+
+static auto generate_header(ecsact::codegen_plugin_context ctx) -> void {
+	ctx.writef("#pragma once\n\n");
+
+	inc_header(ctx, "CoreMinimal.h");
+	inc_header(ctx, "UObject/Interface.h");
+	ctx.writef("#include <array>\n");
+	ctx.writef("#include <type_traits>\n");
+	inc_header(ctx, "ecsact/runtime/common.h");
+	inc_header(ctx, "EcsactUnreal/Ecsact.h");
+	inc_header(ctx, "EcsactUnreal/EcsactComponentMeta.h");
+	inc_header(ctx, "EcsactUnreal/EcsactComponentSparseSet.h");
+	inc_header(ctx, "EcsactUnreal/EcsactRunnerSubsystem.h");
+	inc_package_header(ctx, ctx.package_id, ".hh");
+	for(auto dep_id : ecsact::meta::get_dependencies(ctx.package_id)) {
+		// Fields may use enums generated in imported packages
+		inc_package_header_no_ext(ctx, dep_id, "__ecsact__ue.h");
+	}
+	inc_package_header_no_ext(ctx, ctx.package_id, "__ecsact__ue.generated.h");
+
+	auto package_pascal_name =
+		ecsact_decl_name_to_pascal(ecsact::meta::package_name(ctx.package_id));
+
+	ctx.writef("\n\n");
+
+	block(ctx, "namespace EcsactUnreal::CodegenMeta", [&] {
+		print_ecsact_unreal_package_meta(package_pascal_name, ctx);
+	});
+	ctx.writef("\n\n");
+
+	for(auto enum_id : ecsact::meta::get_enum_ids(ctx.package_id)) {
+		print_uenum(ctx, enum_id);
+	}
+
+	for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
+		print_ustruct(ctx, comp_id);
+	}
+
+	ctx.write(std::format(
+		"\nUCLASS(Abstract, Blueprintable, meta = "
+		"(DisplayName = \"Ecsact Runner Package Subsystem ({})\"))\n",
+		ecsact::meta::package_name(ctx.package_id)
+	));
+	block(
+		ctx,
+		std::format(
+			"class U{}EcsactRunnerSubsystem : public UEcsactRunnerSubsystem",
+			package_pascal_name
+		),
+		[&] {
+			ctx.writef("GENERATED_BODY() // NOLINT\n\n");
+
+			ctx.write(
+				"TArray<void(ThisClass::*)(int32, const void*)> InitComponentFns;\n"
+				"TArray<void(ThisClass::*)(int32, const void*)> UpdateComponentFns;\n"
+				"TArray<void(ThisClass::*)(int32, const void*)> RemoveComponentFns;\n"
+			);
+
+			for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
+				auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
+				auto comp_type_cpp_name = cpp_identifier(comp_full_name);
+				auto comp_name = ecsact::meta::component_name(comp_id);
+				auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+
+				ctx.write(std::format(
+					"void RawInit{0}(int32 Entity, const void* Component);\n",
+					comp_pascal_name
+				));
+
+				ctx.write(std::format(
+					"void RawUpdate{0}(int32 Entity, const void* Component);\n",
+					comp_pascal_name
+				));
+
+				ctx.write(std::format(
+					"void RawRemove{0}(int32 Entity, const void* Component);\n",
+					comp_pascal_name
+				));
+			}
+
+			ctx.indentation -= 1;
+			ctx.writef("\n");
+			ctx.writef("protected:");
+			ctx.indentation += 1;
+			ctx.writef("\n");
+
+			ctx.write(
+				"void InitComponentRaw("
+				"ecsact_entity_id, ecsact_component_id, const void*) override;\n"
+				"void UpdateComponentRaw("
+				"ecsact_entity_id, ecsact_component_id, const void*) override;\n"
+				"void RemoveComponentRaw("
+				"ecsact_entity_id, ecsact_component_id, const void*) override;\n\n"
+			);
+
+			ctx.indentation -= 1;
+			ctx.writef("\n");
+			ctx.writef("public:");
+			ctx.indentation += 1;
+			ctx.writef("\n");
+
+			ctx.write(
+				std::format("U{}EcsactRunnerSubsystem();\n", package_pascal_name)
+			);
+
+			for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
+				auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
+				auto comp_type_cpp_name = cpp_identifier(comp_full_name);
+				auto comp_name = ecsact::meta::component_name(comp_id);
+				auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+				auto comp_ustruct_name = ecsact_ustruct_name(comp_id);
+				ctx.write(std::format(
+					"\nUFUNCTION(BlueprintNativeEvent, Category = \"Ecsact Runner\", "
+					"meta = (DisplayName = \"Init {}\"))\n",
+					comp_full_name
+				));
+				ctx.write(std::format(
+					"void Init{0}(int32 Entity, {1} {0});\n",
+					comp_pascal_name,
+					comp_ustruct_name
+				));
+				ctx.write(std::format(
+					"virtual void Init{0}_Implementation(int32 Entity, {1} {0});\n",
+					comp_pascal_name,
+					comp_ustruct_name
+				));
+
+				ctx.write(std::format(
+					"\nUFUNCTION(BlueprintNativeEvent, Category = \"Ecsact Runner\", "
+					"meta = (DisplayName = \"Update {}\"))\n",
+					comp_full_name
+				));
+				ctx.write(std::format(
+					"void Update{0}(int32 Entity, {1} {0});\n",
+					comp_pascal_name,
+					comp_ustruct_name
+				));
+				ctx.write(std::format(
+					"virtual void Update{0}_Implementation(int32 Entity, {1} {0});\n",
+					comp_pascal_name,
+					comp_ustruct_name
+				));
+
+				ctx.write(std::format(
+					"\nUFUNCTION(BlueprintNativeEvent, Category = \"Ecsact Runner\", "
+					"meta = (DisplayName = \"Remove {}\"))\n",
+					comp_full_name
+				));
+				ctx.write(std::format(
+					"void Remove{0}(int32 Entity, {1} {0});\n",
+					comp_pascal_name,
+					comp_ustruct_name
+				));
 				ctx.write(std::format(
-					"\nUFUNCTION(BlueprintNativeEvent, Category = \"Ecsact Runner\", "
-					"meta = (DisplayName = \"Remove {}\"))\n",
-					comp_full_name
-				));
-				ctx.write(std::format(
-					"void Remove{0}(int32 Entity, {1} {0});\n",
-					comp_pascal_name,
-					comp_ustruct_name
-				));
-				ctx.write(std::format(
 					"virtual void Remove{0}_Implementation(int32 Entity, {1} {0});\n",
 					comp_pascal_name,
 					comp_ustruct_name
@@ -471,15 +1054,24 @@ static auto generate_header(ecsact::codegen_plugin_context ctx) -> void {
 		}
 	);
 	ctx.writef(";\n");
+
+	print_component_mirror_header(ctx, package_pascal_name);
 }
 
-static auto generate_source(ecsact::codegen_plugin_context ctx) -> void {
+static auto generate_source( //
+	ecsact::codegen_plugin_context ctx,
+	int32_t                        shard
+) -> void {
 	inc_package_header_no_ext(ctx, ctx.package_id, "__ecsact__ue.h");
+	inc_header(ctx, "EcsactUnreal/EcsactSettings.h");
+	inc_header(ctx, "EcsactUnreal/EcsactMemory.h");
+	ctx.write("\n");
 
 	auto package_pascal_name =
 		ecsact_decl_name_to_pascal(ecsact::meta::package_name(ctx.package_id));
 
 	auto comp_ids = ecsact::meta::get_component_ids(ctx.package_id);
+	auto shard_comp_ids = shard_component_ids(ctx.package_id, shard);
 	auto largest_comp_id = 0;
 	for(auto comp_id : comp_ids) {
 		if(static_cast<int>(comp_id) > largest_comp_id) {
@@ -487,7 +1079,7 @@ static auto generate_source(ecsact::codegen_plugin_context ctx) -> void {
 		}
 	}
 
-	for(auto comp_id : comp_ids) {
+	for(auto comp_id : shard_comp_ids) {
 		auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
 		auto comp_name = ecsact::meta::component_name(comp_id);
 		auto comp_type_cpp_name = cpp_identifier(comp_full_name);
@@ -501,19 +1093,25 @@ static auto generate_source(ecsact::codegen_plugin_context ctx) -> void {
 			),
 			[&] {
 				ctx.write(std::format("auto result = {0}{{}};\n", comp_ustruct_name));
+				if(!ecsact::meta::get_field_ids(comp_id).empty()) {
+					ctx.writef(
+						"const auto* component = static_cast<const {}*>(component_data);\n",
+						comp_type_cpp_name
+					);
+				}
 
 				for(auto field_id : ecsact::meta::get_field_ids(comp_id)) {
 					auto field_type = ecsact::meta::get_field_type(comp_id, field_id);
 					auto field_unreal_type = ecsact_type_to_unreal_type(ctx, field_type);
 					auto field_name = ecsact::meta::field_name(comp_id, field_id);
 					auto field_pascal_name = ecsact_decl_name_to_pascal(field_name);
-
-					ctx.write(std::format( //
-						"result.{0} = static_cast<const {1}*>(component_data)->{2};\n",
+					print_field_copy(
+						ctx,
+						field_type,
+						field_unreal_type,
 						field_pascal_name,
-						comp_type_cpp_name,
 						field_name
-					));
+					);
 				}
 
 				ctx.write("return result;");
@@ -522,104 +1120,112 @@ static auto generate_source(ecsact::codegen_plugin_context ctx) -> void {
 		ctx.write("\n");
 	}
 
-	block(
-		ctx,
-		std::format(
-			"U{0}EcsactRunnerSubsystem::U{0}EcsactRunnerSubsystem()",
-			package_pascal_name
-		),
-		[&] {
-			ctx.write("InitComponentFns.Init(nullptr, ", largest_comp_id + 1, ");\n");
-			ctx.write(
-				"UpdateComponentFns.Init(nullptr, ",
-				largest_comp_id + 1,
-				");\n"
-			);
-			ctx.write(
-				"RemoveComponentFns.Init(nullptr, ",
-				largest_comp_id + 1,
-				");\n"
-			);
+	// Shared by every component so only generated once
+	if(shard == 0) {
+		block(
+			ctx,
+			std::format(
+				"U{0}EcsactRunnerSubsystem::U{0}EcsactRunnerSubsystem()",
+				package_pascal_name
+			),
+			[&] {
+				ctx.write("LLM_SCOPE_BYTAG(Ecsact_Subsystems);\n");
+				ctx.write(
+					"InitComponentFns.Init(nullptr, ",
+					largest_comp_id + 1,
+					");\n"
+				);
+				ctx.write(
+					"UpdateComponentFns.Init(nullptr, ",
+					largest_comp_id + 1,
+					");\n"
+				);
+				ctx.write(
+					"RemoveComponentFns.Init(nullptr, ",
+					largest_comp_id + 1,
+					");\n"
+				);
 
-			for(auto comp_id : comp_ids) {
-				auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
-				auto comp_name = ecsact::meta::component_name(comp_id);
-				auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
-				ctx.write(std::format(
-					"InitComponentFns[{}] = &ThisClass::RawInit{};\n",
-					static_cast<int>(comp_id),
-					comp_pascal_name
-				));
-				ctx.write(std::format(
-					"UpdateComponentFns[{}] = &ThisClass::RawUpdate{};\n",
-					static_cast<int>(comp_id),
-					comp_pascal_name
-				));
-				ctx.write(std::format(
-					"RemoveComponentFns[{}] = &ThisClass::RawRemove{};\n",
-					static_cast<int>(comp_id),
-					comp_pascal_name
-				));
+				for(auto comp_id : comp_ids) {
+					auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
+					auto comp_name = ecsact::meta::component_name(comp_id);
+					auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+					ctx.write(std::format(
+						"InitComponentFns[{}] = &ThisClass::RawInit{};\n",
+						static_cast<int>(comp_id),
+						comp_pascal_name
+					));
+					ctx.write(std::format(
+						"UpdateComponentFns[{}] = &ThisClass::RawUpdate{};\n",
+						static_cast<int>(comp_id),
+						comp_pascal_name
+					));
+					ctx.write(std::format(
+						"RemoveComponentFns[{}] = &ThisClass::RawRemove{};\n",
+						static_cast<int>(comp_id),
+						comp_pascal_name
+					));
+				}
 			}
-		}
-	);
-	ctx.write("\n\n");
+		);
+		ctx.write("\n\n");
 
-	block(
-		ctx,
-		std::format(
-			"void U{0}EcsactRunnerSubsystem::InitComponentRaw"
-			"( ecsact_entity_id entity"
-			", ecsact_component_id component_id"
-			", const void* component_data)",
-			package_pascal_name
-		),
-		[&] {
-			ctx.write(
-				"(this->*InitComponentFns[static_cast<int32>(component_id)])"
-				"(static_cast<int32>(entity), component_data);"
-			);
-		}
-	);
-	ctx.writef("\n\n");
+		block(
+			ctx,
+			std::format(
+				"void U{0}EcsactRunnerSubsystem::InitComponentRaw"
+				"( ecsact_entity_id entity"
+				", ecsact_component_id component_id"
+				", const void* component_data)",
+				package_pascal_name
+			),
+			[&] {
+				ctx.write(
+					"(this->*InitComponentFns[static_cast<int32>(component_id)])"
+					"(static_cast<int32>(entity), component_data);"
+				);
+			}
+		);
+		ctx.writef("\n\n");
 
-	block(
-		ctx,
-		std::format(
-			"void U{0}EcsactRunnerSubsystem::UpdateComponentRaw"
-			"( ecsact_entity_id entity"
-			", ecsact_component_id component_id"
-			", const void* component_data)",
-			package_pascal_name
-		),
-		[&] {
-			ctx.write(
-				"(this->*UpdateComponentFns[static_cast<int32>(component_id)])"
-				"(static_cast<int32>(entity), component_data);"
-			);
-		}
-	);
-	ctx.writef("\n\n");
+		block(
+			ctx,
+			std::format(
+				"void U{0}EcsactRunnerSubsystem::UpdateComponentRaw"
+				"( ecsact_entity_id entity"
+				", ecsact_component_id component_id"
+				", const void* component_data)",
+				package_pascal_name
+			),
+			[&] {
+				ctx.write(
+					"(this->*UpdateComponentFns[static_cast<int32>(component_id)])"
+					"(static_cast<int32>(entity), component_data);"
+				);
+			}
+		);
+		ctx.writef("\n\n");
 
-	block(
-		ctx,
-		std::format(
-			"void U{0}EcsactRunnerSubsystem::RemoveComponentRaw"
-			"( ecsact_entity_id entity"
-			", ecsact_component_id component_id"
-			", const void* component_data)",
-			package_pascal_name
-		),
-		[&] {
-			ctx.write(
-				"(this->*RemoveComponentFns[static_cast<int32>(component_id)])"
-				"(static_cast<int32>(entity), component_data);"
-			);
-		}
-	);
-	ctx.writef("\n\n");
+		block(
+			ctx,
+			std::format(
+				"void U{0}EcsactRunnerSubsystem::RemoveComponentRaw"
+				"( ecsact_entity_id entity"
+				", ecsact_component_id component_id"
+				", const void* component_data)",
+				package_pascal_name
+			),
+			[&] {
+				ctx.write(
+					"(this->*RemoveComponentFns[static_cast<int32>(component_id)])"
+					"(static_cast<int32>(entity), component_data);"
+				);
+			}
+		);
+		ctx.writef("\n\n");
+	}
 
-	for(auto comp_id : comp_ids) {
+	for(auto comp_id : shard_comp_ids) {
 		auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
 		auto comp_name = ecsact::meta::component_name(comp_id);
 		auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
@@ -681,7 +1287,7 @@ static auto generate_source(ecsact::codegen_plugin_context ctx) -> void {
 		ctx.write("\n");
 	}
 
-	for(auto comp_id : comp_ids) {
+	for(auto comp_id : shard_comp_ids) {
 		auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
 		auto comp_name = ecsact::meta::component_name(comp_id);
 		auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
@@ -732,6 +1338,10 @@ static auto generate_source(ecsact::codegen_plugin_context ctx) -> void {
 		);
 		ctx.writef("\n\n");
 	}
+
+	if(shard == 0) {
+		print_component_mirror_source(ctx, package_pascal_name);
+	}
 }
 
 static auto generate_mass_header(ecsact::codegen_plugin_context ctx) -> void {
@@ -743,6 +1353,8 @@ static auto generate_mass_header(ecsact::codegen_plugin_context ctx) -> void {
 	inc_header(ctx, "CoreMinimal.h");
 	inc_header(ctx, "MassEntityTypes.h");
 	inc_header(ctx, "MassEntityConfigAsset.h");
+	inc_header(ctx, "MassEntityQuery.h");
+	inc_header(ctx, "MassProcessor.h");
 	inc_header(ctx, "ecsact/runtime/common.h");
 
 	auto pkg_basename = //
@@ -840,7 +1452,10 @@ static auto generate_mass_header(ecsact::codegen_plugin_context ctx) -> void {
 			ctx.write("public:\n");
 			ctx.writef(
 				"virtual auto GetEcsactMassEntityHandles(int32 Entity) -> "
-				"TArray<FMassEntityHandle>;\n"
+				"TConstArrayView<FMassEntityHandle>;\n"
+			);
+			ctx.writef(
+				"auto EntityDestroyed_Implementation(int32 Entity) -> void override;\n"
 			);
 
 			for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
@@ -878,6 +1493,48 @@ static auto generate_mass_header(ecsact::codegen_plugin_context ctx) -> void {
 					comp_ustruct_name
 				);
 			}
+
+			ctx.writef("\n");
+			ctx.writef(
+				"/**\n"
+				" * Stage component updates instead of pushing a deferred command per "
+				"update.\n"
+				" * Staged updates are applied in parallel by the generated "
+				"U{}*MassProcessor\n"
+				" * classes.\n"
+				" */\n",
+				package_pascal_name
+			);
+			ctx.writef("UPROPERTY(EditAnywhere, Category = \"Ecsact Mass\")\n");
+			ctx.writef("bool bStageFragmentUpdates = false;\n");
+
+			ctx.writef("\nprivate:\n");
+			for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
+				auto comp_name = ecsact::meta::component_name(comp_id);
+				auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+				auto comp_ustruct_name = ecsact_ustruct_name(comp_id);
+
+				if(ecsact::meta::get_field_ids(comp_id).empty()) {
+					continue;
+				}
+
+				ctx.writef(
+					"friend class {};\n",
+					to_comp_mass_processor_name(package_pascal_name, comp_pascal_name)
+				);
+				ctx.writef(
+					"/** Staged {} updates indexed by ecsact_entity_id */\n",
+					comp_pascal_name
+				);
+				ctx.writef(
+					"TArray<{}> Staged{};\n",
+					comp_ustruct_name,
+					comp_pascal_name
+				);
+				// One byte per entity so processor chunks can clear it in parallel
+				ctx.writef("TArray<bool> Staged{}Mask;\n", comp_pascal_name);
+				ctx.writef("bool bHasStaged{} = false;\n", comp_pascal_name);
+			}
 		}
 	);
 	// "(DisplayName = \"Ecsact Runner Package Subsystem ({})\"))\n",
@@ -894,7 +1551,13 @@ static auto generate_mass_header(ecsact::codegen_plugin_context ctx) -> void {
 			ctx.writef("GENERATED_BODY()\n\n");
 
 			ctx.writef(
-				"TMap<ecsact_entity_id, TArray<FMassEntityHandle>> MassEntities;\n"
+				"/** Mass entity handles indexed by ecsact_entity_id */\n"
+				"TArray<TArray<FMassEntityHandle, TInlineAllocator<1>>> "
+				"MassEntities;\n"
+			);
+			ctx.writef(
+				"/** Scratch buffer reused by each EntityCreated spawn */\n"
+				"TArray<FMassEntityHandle> SpawnedEntityHandles;\n\n"
 			);
 			ctx.writef("protected:\n");
 
@@ -911,7 +1574,7 @@ static auto generate_mass_header(ecsact::codegen_plugin_context ctx) -> void {
 
 			ctx.writef(
 				"auto GetEcsactMassEntityHandles(int32 Entity) -> "
-				"TArray<FMassEntityHandle> override;\n"
+				"TConstArrayView<FMassEntityHandle> override;\n"
 			);
 
 			ctx.writef(
@@ -920,14 +1583,63 @@ static auto generate_mass_header(ecsact::codegen_plugin_context ctx) -> void {
 		}
 	);
 	ctx.writef(";\n");
+
+	for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
+		auto comp_name = ecsact::meta::component_name(comp_id);
+		auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+
+		if(ecsact::meta::get_field_ids(comp_id).empty()) {
+			continue;
+		}
+
+		ctx.writef(
+			"\n/**\n"
+			" * Applies {0} updates staged by {1} (see bStageFragmentUpdates)\n"
+			" */\n",
+			ecsact::meta::decl_full_name(comp_id),
+			mass_spawner_name
+		);
+		ctx.writef("UCLASS()\n");
+		block(
+			ctx,
+			std::format(
+				"class {} : public UMassProcessor",
+				to_comp_mass_processor_name(package_pascal_name, comp_pascal_name)
+			),
+			[&] {
+				ctx.writef("GENERATED_BODY()\n\n");
+				ctx.writef("FMassEntityQuery EntityQuery;\n\n");
+				ctx.writef("public:\n");
+				ctx.writef(
+					"{}();\n\n",
+					to_comp_mass_processor_name(package_pascal_name, comp_pascal_name)
+				);
+				ctx.writef("protected:\n");
+				ctx.writef("auto ConfigureQueries() -> void override;\n");
+				ctx.writef(
+					"auto Execute(FMassEntityManager& EntityManager, "
+					"FMassExecutionContext& Context) -> void override;\n"
+				);
+			}
+		);
+		ctx.writef(";\n");
+	}
 }
 
-static auto generate_mass_source(ecsact::codegen_plugin_context ctx) -> void {
+static auto generate_mass_source( //
+	ecsact::codegen_plugin_context ctx,
+	int32_t                        shard
+) -> void {
 	inc_package_header_no_ext(ctx, ctx.package_id, "__ecsact__mass__ue.h");
 	inc_header(ctx, "Engine/World.h");
 	inc_header(ctx, "MassEntitySubsystem.h");
 	inc_header(ctx, "MassSpawnerSubsystem.h");
 	inc_header(ctx, "MassCommandBuffer.h");
+	inc_header(ctx, "MassCommonTypes.h");
+	inc_header(ctx, "MassExecutionContext.h");
+	inc_header(ctx, "EcsactUnreal/EcsactExecution.h");
+	inc_header(ctx, "EcsactUnreal/EcsactMemory.h");
+	inc_header(ctx, "EcsactUnreal/EcsactRunner.h");
 	ctx.writef("\n");
 
 	auto package_pascal_name =
@@ -936,8 +1648,9 @@ static auto generate_mass_source(ecsact::codegen_plugin_context ctx) -> void {
 	auto mass_spawner_name = package_pascal_to_mass_spawner(package_pascal_name);
 	auto one_to_one_spawner_name =
 		package_pascal_to_one_to_one(package_pascal_name);
+	auto shard_comp_ids = shard_component_ids(ctx.package_id, shard);
 
-	for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
+	for(auto comp_id : shard_comp_ids) {
 		auto comp_full_name = ecsact::meta::decl_full_name(comp_id);
 		auto comp_type_cpp_name = cpp_identifier(comp_full_name);
 		auto comp_name = ecsact::meta::component_name(comp_id);
@@ -1003,6 +1716,28 @@ static auto generate_mass_source(ecsact::codegen_plugin_context ctx) -> void {
 					mass_spawner_name
 				),
 				[&] {
+					block(ctx, "if(bStageFragmentUpdates)", [&] {
+						block(
+							ctx,
+							std::format("if(Staged{}.Num() <= Entity)", comp_pascal_name),
+							[&] {
+								ctx.writef("Staged{}.SetNum(Entity + 1);\n", comp_pascal_name);
+								ctx.writef(
+									"Staged{}Mask.SetNumZeroed(Entity + 1);",
+									comp_pascal_name
+								);
+							}
+						);
+						ctx.writef("\n");
+						ctx.writef(
+							"Staged{0}[Entity] = {0};\n"
+							"Staged{0}Mask[Entity] = true;\n"
+							"bHasStaged{0} = true;\n"
+							"return;",
+							comp_pascal_name
+						);
+					});
+					ctx.writef("\n");
 					ctx.writef("auto* world = GetWorld();\n");
 					ctx.writef("check(world);\n\n");
 					ctx.writef(
@@ -1064,6 +1799,19 @@ static auto generate_mass_source(ecsact::codegen_plugin_context ctx) -> void {
 				mass_spawner_name
 			),
 			[&] {
+				if(fields.size() > 0) {
+					block(
+						ctx,
+						std::format(
+							"if(Staged{0}Mask.IsValidIndex(Entity))",
+							comp_pascal_name
+						),
+						[&] {
+							ctx.writef("Staged{}Mask[Entity] = false;", comp_pascal_name);
+						}
+					);
+					ctx.writef("\n");
+				}
 				ctx.writef("auto* world = GetWorld();\n");
 				ctx.writef("check(world);\n\n");
 				ctx.writef(
@@ -1092,140 +1840,305 @@ static auto generate_mass_source(ecsact::codegen_plugin_context ctx) -> void {
 		ctx.writef("\n");
 	}
 
-	block(
-		ctx,
-		std::format(
-			"auto {}::GetEcsactMassEntityHandles(int32 "
-			"Entity) -> TArray<FMassEntityHandle>",
-			mass_spawner_name
-		),
-		[&] {
-			ctx.writef(
-				"UE_LOG(LogTemp, Error, TEXT(\"GetEcsactMassEntityHandless must be "
-				"implemented for "
-				"EcsactMassEntitySpawner\"));\n"
-			);
-			ctx.writef("return TArray<FMassEntityHandle>{{}};\n");
-		}
-	);
-	ctx.writef("\n");
-
-	block(
-		ctx,
-		std::format(
-			"auto {}::EntityCreated_Implementation(int32 Entity) -> void",
-			one_to_one_spawner_name
-		),
-		[&] {
-			ctx.writef("auto* world = GetWorld();\n");
-			ctx.writef("check(world);\n\n");
-			ctx.writef("auto* config = GetEntityMassConfig();\n");
-			block(ctx, "if(!config)", [&] {
-				print_ue_warning(
-					ctx,
-					"%s GetEntityMassConfig() returned null",
-					"*GetClass()->GetName()"
+	// Shared by every component so only generated once
+	if(shard == 0) {
+		block(
+			ctx,
+			std::format(
+				"auto {}::GetEcsactMassEntityHandles(int32 "
+				"Entity) -> TConstArrayView<FMassEntityHandle>",
+				mass_spawner_name
+			),
+			[&] {
+				ctx.writef(
+					"UE_LOG(LogTemp, Error, TEXT(\"GetEcsactMassEntityHandless must be "
+					"implemented for "
+					"EcsactMassEntitySpawner\"));\n"
 				);
-				ctx.writef("return;");
-			});
-			ctx.writef("\n");
-			ctx.writef(
-				"const auto& entity_template = "
-				"config->GetOrCreateEntityTemplate(*world);\n"
-			);
-
-			ctx.writef("auto new_entity_handles = TArray<FMassEntityHandle>{{}};\n\n"
-			);
+				ctx.writef("return {{}};\n");
+			}
+		);
+		ctx.writef("\n");
 
-			ctx.writef(
-				"auto  mass_spawner = world->GetSubsystem<UMassSpawnerSubsystem>();\n"
-			);
-			ctx.writef(
-				"auto& entity_manager = "
-				"world->GetSubsystem<UMassEntitySubsystem>()->GetMutableEntityManager()"
-				";\n\n"
-			);
+		block(
+			ctx,
+			std::format(
+				"auto {}::EntityDestroyed_Implementation(int32 Entity) -> void",
+				mass_spawner_name
+			),
+			[&] {
+				for(auto comp_id : ecsact::meta::get_component_ids(ctx.package_id)) {
+					auto comp_name = ecsact::meta::component_name(comp_id);
+					auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+					if(ecsact::meta::get_field_ids(comp_id).empty()) {
+						continue;
+					}
+					block(
+						ctx,
+						std::format(
+							"if(Staged{0}Mask.IsValidIndex(Entity))",
+							comp_pascal_name
+						),
+						[&] {
+							ctx.writef("Staged{}Mask[Entity] = false;", comp_pascal_name);
+						}
+					);
+					ctx.writef("\n");
+				}
+			}
+		);
+		ctx.writef("\n");
 
-			ctx.writef(
-				"mass_spawner->SpawnEntities(entity_template, 1, new_entity_handles);\n"
-			);
+		block(
+			ctx,
+			std::format(
+				"auto {}::EntityCreated_Implementation(int32 Entity) -> void",
+				one_to_one_spawner_name
+			),
+			[&] {
+				ctx.writef("auto* world = GetWorld();\n");
+				ctx.writef("check(world);\n\n");
+				ctx.writef("auto* config = GetEntityMassConfig();\n");
+				block(ctx, "if(!config)", [&] {
+					print_ue_warning(
+						ctx,
+						"%s GetEntityMassConfig() returned null",
+						"*GetClass()->GetName()"
+					);
+					ctx.writef("return;");
+				});
+				ctx.writef("\n");
+				ctx.writef(
+					"const auto& entity_template = "
+					"config->GetOrCreateEntityTemplate(*world);\n"
+				);
 
-			ctx.writef(
-				"MassEntities.Add(static_cast<ecsact_entity_id>(Entity), "
-				"new_entity_handles);\n"
-			);
+				ctx.writef(
+					"auto  mass_spawner = world->GetSubsystem<UMassSpawnerSubsystem>();\n"
+				);
+				ctx.writef(
+					"auto& entity_manager = "
+					"world->GetSubsystem<UMassEntitySubsystem>()->"
+					"GetMutableEntityManager();\n\n"
+				);
 
-			block(ctx, "for(auto entity_handle : new_entity_handles)", [&] {
+				ctx.writef("LLM_SCOPE_BYTAG(Ecsact_Mass);\n");
+				ctx.writef("SpawnedEntityHandles.Reset();\n");
 				ctx.writef(
-					"entity_manager.Defer().AddFragment<FEcsactEntityFragment>(entity_"
-					"handle);\n"
+					"mass_spawner->SpawnEntities(entity_template, 1, "
+					"SpawnedEntityHandles);\n\n"
 				);
+
+				block(ctx, "if(MassEntities.Num() <= Entity)", [&] {
+					ctx.writef("MassEntities.SetNum(Entity + 1);");
+				});
+				ctx.writef("\n");
+				ctx.writef("MassEntities[Entity].Reset();\n");
+				ctx.writef("MassEntities[Entity].Append(SpawnedEntityHandles);\n\n");
+
+				block(ctx, "for(auto entity_handle : SpawnedEntityHandles)", [&] {
+					ctx.writef(
+						"entity_manager.Defer().AddFragment<FEcsactEntityFragment>(entity_"
+						"handle);\n"
+					);
+					ctx.writef(
+						"entity_manager.Defer()"
+						".PushCommand<FMassCommandAddFragmentInstances>(entity_handle, "
+						"FEcsactEntityFragment{{static_cast<ecsact_entity_id>(Entity)}});"
+						"\n"
+					);
+					ctx.writef(";\n");
+				});
+			}
+		);
+
+		block(
+			ctx,
+			std::format(
+				"auto {}::EntityDestroyed_Implementation(int32 Entity) -> "
+				"void",
+				one_to_one_spawner_name
+			),
+			[&] {
+				ctx.writef("Super::EntityDestroyed_Implementation(Entity);\n\n");
+				ctx.writef("auto* world = GetWorld();\n");
+				ctx.writef("check(world);\n\n");
 				ctx.writef(
-					"entity_manager.Defer().PushCommand<FMassCommandAddFragmentInstances>"
-					"(entity_handle, "
-					"FEcsactEntityFragment{{static_cast<ecsact_entity_id>(Entity)}});"
-					"\n"
+					"auto& entity_manager = "
+					"world->GetSubsystem<UMassEntitySubsystem>()->"
+					"GetMutableEntityManager();\n\n"
 				);
-				ctx.writef(";\n");
-			});
-		}
-	);
 
-	block(
-		ctx,
-		std::format(
-			"auto {}::EntityDestroyed_Implementation(int32 Entity) -> "
-			"void",
-			one_to_one_spawner_name
-		),
-		[&] {
-			ctx.writef("auto* world = GetWorld();\n");
-			ctx.writef("check(world);\n\n");
-			ctx.writef(
-				"auto& entity_manager = "
-				"world->GetSubsystem<UMassEntitySubsystem>()->GetMutableEntityManager()"
-				";\n\n"
-			);
+				block(ctx, "if(!MassEntities.IsValidIndex(Entity))", [&] {
+					ctx.writef("return;");
+				});
+				ctx.writef("\n");
+				ctx.writef("auto& old_entity_handles = MassEntities[Entity];\n");
 
-			ctx.writef("auto old_entity_handles = TArray<FMassEntityHandle>{{}};\n");
-			ctx.writef(
-				"MassEntities.RemoveAndCopyValue(static_cast<ecsact_entity_id>(Entity),"
-				"old_entity_handles);\n"
-			);
+				block(ctx, "for(auto entity_handle : old_entity_handles)", [&] {
+					ctx.writef("entity_manager.Defer().DestroyEntity(entity_handle);\n");
+				});
+				ctx.writef("\n");
+				ctx.writef("old_entity_handles.Reset();\n");
+			}
+		);
 
-			block(ctx, "for(auto entity_handle : old_entity_handles)", [&] {
-				ctx.writef("entity_manager.Defer().DestroyEntity(entity_handle);\n");
-			});
-		}
-	);
+		ctx.writef("\n");
+		block(
+			ctx,
+			std::format(
+				"auto {}::GetEcsactMassEntityHandles(int32 Entity) -> "
+				"TConstArrayView<FMassEntityHandle>",
+				one_to_one_spawner_name
+			),
+			[&] {
+				ctx.writef("if(!MassEntities.IsValidIndex(Entity)) return {{}};\n");
+				ctx.writef("return MassEntities[Entity];\n");
+			}
+		);
 
-	ctx.writef("\n");
-	block(
-		ctx,
-		std::format(
-			"auto {}::GetEcsactMassEntityHandles(int32 Entity) -> "
-			"TArray<FMassEntityHandle>",
-			one_to_one_spawner_name
-		),
-		[&] {
-			ctx.writef(
-				"auto handles = "
-				"MassEntities.Find(static_cast<ecsact_entity_id>(Entity));\n"
-			);
-			ctx.writef("if(!handles) return {{}};\n");
-			ctx.writef("return *handles;\n");
+		ctx.writef("\n");
+		block(
+			ctx,
+			std::format(
+				"auto {}::GetEntityMassConfig() const -> UMassEntityConfigAsset*\n",
+				one_to_one_spawner_name
+			),
+			[&] { ctx.writef("return MassEntityConfigAsset;\n"); }
+		);
+	}
+
+	for(auto comp_id : shard_comp_ids) {
+		auto comp_name = ecsact::meta::component_name(comp_id);
+		auto comp_pascal_name = ecsact_decl_name_to_pascal(comp_name);
+		auto comp_fragment_name =
+			to_comp_fragment_name(package_pascal_name, comp_pascal_name);
+		auto processor_name =
+			to_comp_mass_processor_name(package_pascal_name, comp_pascal_name);
+
+		if(ecsact::meta::get_field_ids(comp_id).empty()) {
+			continue;
 		}
-	);
 
-	ctx.writef("\n");
-	block(
-		ctx,
-		std::format(
-			"auto {}::GetEntityMassConfig() const -> UMassEntityConfigAsset*\n",
-			one_to_one_spawner_name
-		),
-		[&] { ctx.writef("return MassEntityConfigAsset;\n"); }
-	);
+		ctx.writef("\n");
+		block(
+			ctx,
+			std::format("{0}::{0}() : EntityQuery(*this)", processor_name),
+			[&] {
+				ctx.writef(
+					"ExecutionFlags = "
+					"static_cast<int32>(EProcessorExecutionFlags::All);\n"
+				);
+				// Applied with the world sync processors so game processors running
+				// later in the frame see the staged updates
+				ctx.writef(
+					"ProcessingPhase = EMassProcessingPhase::PrePhysics;\n"
+					"ExecutionOrder.ExecuteInGroup = "
+					"UE::Mass::ProcessorGroupNames::SyncWorldToMass;\n"
+				);
+				// Staged updates are owned by the spawner and cleared here
+				ctx.writef("bRequiresGameThreadExecution = true;\n");
+			}
+		);
+		ctx.writef("\n");
+
+		block(
+			ctx,
+			std::format("auto {}::ConfigureQueries() -> void", processor_name),
+			[&] {
+				ctx.writef(
+					"EntityQuery.AddRequirement<FEcsactEntityFragment>("
+					"EMassFragmentAccess::ReadOnly);\n"
+				);
+				ctx.writef(
+					"EntityQuery.AddRequirement<{}>(EMassFragmentAccess::ReadWrite);\n",
+					comp_fragment_name
+				);
+			}
+		);
+		ctx.writef("\n");
+
+		block(
+			ctx,
+			std::format(
+				"auto {}::Execute(FMassEntityManager& EntityManager, "
+				"FMassExecutionContext& Context) -> void",
+				processor_name
+			),
+			[&] {
+				ctx.writef(
+					"auto runner = EcsactUnrealExecution::Runner("
+					"EntityManager.GetWorld());\n"
+				);
+				block(ctx, "if(!runner.IsValid())", [&] { ctx.writef("return;"); });
+				ctx.writef("\n");
+				ctx.writef(
+					"auto spawner = runner->GetSubsystem<{}>();\n",
+					mass_spawner_name
+				);
+				block(
+					ctx,
+					std::format(
+						"if(!spawner || !spawner->bHasStaged{})",
+						comp_pascal_name
+					),
+					[&] { ctx.writef("return;"); }
+				);
+				ctx.writef("\n");
+				ctx.writef(
+					"const auto& staged = spawner->Staged{0};\n"
+					"auto& staged_mask = spawner->Staged{0}Mask;\n\n",
+					comp_pascal_name
+				);
+
+				block(
+					ctx,
+					"EntityQuery.ParallelForEachEntityChunk("
+					"EntityManager, Context, [&](FMassExecutionContext& ChunkContext)",
+					[&] {
+						ctx.writef(
+							"const auto ecsact_entities = "
+							"ChunkContext.GetFragmentView<FEcsactEntityFragment>();\n"
+						);
+						ctx.writef(
+							"const auto fragments = "
+							"ChunkContext.GetMutableFragmentView<{}>();\n",
+							comp_fragment_name
+						);
+						block(
+							ctx,
+							"for(int32 i = 0; ChunkContext.GetNumEntities() > i; ++i)",
+							[&] {
+								ctx.writef(
+									"auto entity = "
+									"static_cast<int32>(ecsact_entities[i].GetId());\n"
+								);
+								block(
+									ctx,
+									"if(staged_mask.IsValidIndex(entity) && staged_mask[entity])",
+									[&] {
+										ctx.writef(
+											"fragments[i].component = staged[entity];\n"
+											"staged_mask[entity] = false;"
+										);
+									}
+								);
+							}
+						);
+					}
+				);
+				ctx.writef(");\n\n");
+
+				// Only applied updates were cleared. Entities whose fragment hasn't
+				// been added yet (Init uses a deferred AddFragment) keep their update.
+				ctx.writef(
+					"spawner->bHasStaged{0} = spawner->Staged{0}Mask.Contains(true);\n",
+					comp_pascal_name
+				);
+			}
+		);
+		ctx.writef("\n");
+	}
 }
 
 auto ecsact_codegen_plugin(
@@ -1234,11 +2147,28 @@ auto ecsact_codegen_plugin(
 	ecsact_codegen_report_fn_t report_fn
 ) -> void {
 	generate_header({package_id, GENERATED_HEADER_INDEX, write_fn, report_fn});
-	generate_source({package_id, GENERATED_SOURCE_INDEX, write_fn, report_fn});
+	generate_source(
+		{package_id, GENERATED_SOURCE_INDEX, write_fn, report_fn},
+		0
+	);
 	generate_mass_header(
 		{package_id, GENERATED_MASS_HEADER_INDEX, write_fn, report_fn}
 	);
 	generate_mass_source(
-		{package_id, GENERATED_MASS_SOURCE_INDEX, write_fn, report_fn}
+		{package_id, GENERATED_MASS_SOURCE_INDEX, write_fn, report_fn},
+		0
 	);
+
+	// Output indices must match ecsact_codegen_output_filenames
+	auto shard_count = source_shard_count(package_id);
+	for(auto shard = 1; shard_count > shard; ++shard) {
+		generate_source(
+			{package_id, GENERATED_SHARDS_INDEX + shard - 1, write_fn, report_fn},
+			shard
+		);
+	}
+	for(auto shard = 1; shard_count > shard; ++shard) {
+		auto index = GENERATED_SHARDS_INDEX + (shard_count - 1) + shard - 1;
+		generate_mass_source({package_id, index, write_fn, report_fn}, shard);
+	}
 }
@@ -0,0 +1,473 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+// Stand-in for an Ecsact runtime built as its own shared library. Implements
+// enough of the core and async APIs for UEcsactSyncRunner and
+// UEcsactAsyncRunner to run against it and emits synthetic event streams at
+// configurable rates. No systems are executed and actions are ignored.
+//
+// NOTE: the mock is not thread safe. All calls are expected on one thread
+// (the game thread when used through the runners.)
+
+#include "EcsactMockRuntime.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "ecsact/runtime/async.h"
+#include "ecsact/runtime/core.h"
+
+#ifdef _WIN32
+#	define ECSACT_MOCK_RUNTIME_EXPORT extern "C" __declspec(dllexport)
+#else
+#	define ECSACT_MOCK_RUNTIME_EXPORT \
+		extern "C" __attribute__((visibility("default")))
+#endif
+
+namespace {
+struct mock_world {
+	ecsact_mock_runtime_options   options;
+	std::mt19937                  rng;
+	std::vector<ecsact_entity_id> entities;
+	std::vector<std::byte>        payload;
+	int32_t                       next_entity_id = 0;
+	size_t                        update_cursor = 0;
+	int32_t                       tick = 0;
+
+	explicit mock_world(const ecsact_mock_runtime_options& options)
+		: options(options), rng(options.seed) {
+		payload.resize(std::max(options.component_size, 0));
+	}
+};
+
+/**
+ * Async execution options are copied when enqueued. Only entity creates and
+ * destroys are kept since component data sizes are unknown to the mock.
+ */
+struct mock_request {
+	ecsact_async_request_id                   id;
+	int32_t                                   done_tick;
+	std::vector<ecsact_placeholder_entity_id> create_entities;
+	std::vector<ecsact_entity_id>             destroy_entities;
+};
+
+struct mock_session {
+	mock_world                world;
+	std::vector<mock_request> requests;
+	bool                      started = false;
+};
+
+auto env_int(const char* name, int64_t default_value) -> int64_t {
+	auto value = std::getenv(name);
+	if(value == nullptr || *value == '\0') {
+		return default_value;
+	}
+	return std::strtoll(value, nullptr, 10);
+}
+
+auto default_options() -> ecsact_mock_runtime_options {
+	return ecsact_mock_runtime_options{
+		.entity_count = static_cast<int32_t>( //
+			env_int("ECSACT_MOCK_ENTITY_COUNT", 1000)
+		),
+		.component_id = static_cast<int32_t>( //
+			env_int("ECSACT_MOCK_COMPONENT_ID", -1)
+		),
+		.component_size = static_cast<int32_t>( //
+			env_int("ECSACT_MOCK_COMPONENT_SIZE", 16)
+		),
+		.updates_per_tick = static_cast<int32_t>( //
+			env_int("ECSACT_MOCK_UPDATES_PER_TICK", 1000)
+		),
+		.update_jitter = static_cast<int32_t>( //
+			env_int("ECSACT_MOCK_UPDATE_JITTER", 0)
+		),
+		.request_latency_ticks = static_cast<int32_t>( //
+			env_int("ECSACT_MOCK_REQUEST_LATENCY_TICKS", 1)
+		),
+		.request_latency_jitter = static_cast<int32_t>( //
+			env_int("ECSACT_MOCK_REQUEST_LATENCY_JITTER", 0)
+		),
+		.seed = static_cast<uint32_t>(env_int("ECSACT_MOCK_SEED", 0)),
+	};
+}
+
+/**
+ * A component id is required because generated code indexes its handlers by
+ * component id. There is no id that is safe to make up.
+ */
+auto check_options(const ecsact_mock_runtime_options& options) -> bool {
+	if(options.component_id < 0) {
+		std::fprintf(
+			stderr,
+			"EcsactMockRuntime: set ECSACT_MOCK_COMPONENT_ID or "
+			"ecsact_mock_runtime_options::component_id to a component of the "
+			"loaded schema\n"
+		);
+		return false;
+	}
+	return true;
+}
+
+auto configured_options() -> ecsact_mock_runtime_options& {
+	static auto options = default_options();
+	return options;
+}
+
+auto registries = std::unordered_map<int32_t, mock_world>{};
+auto last_registry_id = int32_t{};
+auto sessions = std::unordered_map<int32_t, mock_session>{};
+auto last_session_id = int32_t{};
+auto last_request_id = int32_t{};
+
+auto emit_entity_created(
+	mock_world&                              world,
+	ecsact_placeholder_entity_id             placeholder_id,
+	const ecsact_execution_events_collector* evc
+) -> ecsact_entity_id {
+	auto entity = static_cast<ecsact_entity_id>(world.next_entity_id++);
+	world.entities.push_back(entity);
+	if(evc && evc->entity_created_callback) {
+		evc->entity_created_callback(
+			ECSACT_EVENT_CREATED_ENTITY,
+			entity,
+			placeholder_id,
+			evc->entity_created_callback_user_data
+		);
+	}
+	return entity;
+}
+
+auto emit_entity_destroyed(
+	mock_world&                              world,
+	ecsact_entity_id                         entity,
+	const ecsact_execution_events_collector* evc
+) -> void {
+	auto itr = std::find(world.entities.begin(), world.entities.end(), entity);
+	if(itr == world.entities.end()) {
+		return;
+	}
+	*itr = world.entities.back();
+	world.entities.pop_back();
+
+	if(evc && evc->entity_destroyed_callback) {
+		evc->entity_destroyed_callback(
+			ECSACT_EVENT_DESTROYED_ENTITY,
+			entity,
+			ECSACT_INVALID_ID(placeholder_entity),
+			evc->entity_destroyed_callback_user_data
+		);
+	}
+}
+
+/**
+ * Ticks the world once. Entities are created on the first tick and synthetic
+ * updates are emitted every tick.
+ */
+auto tick_world( //
+	mock_world&                              world,
+	const ecsact_execution_events_collector* evc
+) -> void {
+	auto component_id = //
+		static_cast<ecsact_component_id>(world.options.component_id);
+	world.tick += 1;
+
+	if(world.tick == 1) {
+		for(auto i = 0; world.options.entity_count > i; ++i) {
+			auto entity = emit_entity_created( //
+				world,
+				ECSACT_INVALID_ID(placeholder_entity),
+				evc
+			);
+			if(evc && evc->init_callback) {
+				evc->init_callback(
+					ECSACT_EVENT_INIT_COMPONENT,
+					entity,
+					component_id,
+					world.payload.data(),
+					evc->init_callback_user_data
+				);
+			}
+		}
+	}
+
+	if(world.entities.empty() || !evc || !evc->update_callback) {
+		return;
+	}
+
+	auto update_count = world.options.updates_per_tick;
+	if(world.options.update_jitter > 0) {
+		auto jitter = std::uniform_int_distribution<int32_t>{
+			-world.options.update_jitter,
+			world.options.update_jitter,
+		};
+		update_count = std::max(update_count + jitter(world.rng), 0);
+	}
+
+	if(world.payload.size() >= sizeof(int32_t)) {
+		std::memcpy(world.payload.data(), &world.tick, sizeof(int32_t));
+	}
+
+	for(auto i = 0; update_count > i; ++i) {
+		auto entity = world.entities[world.update_cursor % world.entities.size()];
+		world.update_cursor += 1;
+		evc->update_callback(
+			ECSACT_EVENT_UPDATE_COMPONENT,
+			entity,
+			component_id,
+			world.payload.data(),
+			evc->update_callback_user_data
+		);
+	}
+}
+
+/**
+ * Echoes @p options back as events. Only usable while the component data in
+ * @p options is alive since the mock does not know component sizes.
+ */
+auto apply_execution_options(
+	mock_world&                              world,
+	const ecsact_execution_options&          options,
+	const ecsact_execution_events_collector* evc
+) -> void {
+	for(auto i = 0; options.create_entities_length > i; ++i) {
+		auto entity = emit_entity_created(world, options.create_entities[i], evc);
+		if(!evc || !evc->init_callback) {
+			continue;
+		}
+		auto comps_length = options.create_entities_components_length[i];
+		auto comps = options.create_entities_components[i];
+		for(auto ci = 0; comps_length > ci; ++ci) {
+			evc->init_callback(
+				ECSACT_EVENT_INIT_COMPONENT,
+				entity,
+				comps[ci].component_id,
+				comps[ci].component_data,
+				evc->init_callback_user_data
+			);
+		}
+	}
+
+	if(evc) {
+		if(options.add_components_entities && evc->init_callback) {
+			for(auto i = 0; options.add_components_length > i; ++i) {
+				evc->init_callback(
+					ECSACT_EVENT_INIT_COMPONENT,
+					options.add_components_entities[i],
+					options.add_components[i].component_id,
+					options.add_components[i].component_data,
+					evc->init_callback_user_data
+				);
+			}
+		}
+		if(options.update_components_entities && evc->update_callback) {
+			for(auto i = 0; options.update_components_length > i; ++i) {
+				evc->update_callback(
+					ECSACT_EVENT_UPDATE_COMPONENT,
+					options.update_components_entities[i],
+					options.update_components[i].component_id,
+					options.update_components[i].component_data,
+					evc->update_callback_user_data
+				);
+			}
+		}
+		if(options.remove_components_entities && evc->remove_callback) {
+			for(auto i = 0; options.remove_components_length > i; ++i) {
+				evc->remove_callback(
+					ECSACT_EVENT_REMOVE_COMPONENT,
+					options.remove_components_entities[i],
+					options.remove_components[i],
+					nullptr,
+					evc->remove_callback_user_data
+				);
+			}
+		}
+	}
+
+	for(auto i = 0; options.destroy_entities_length > i; ++i) {
+		emit_entity_destroyed(world, options.destroy_entities[i], evc);
+	}
+}
+} // namespace
+
+ECSACT_MOCK_RUNTIME_EXPORT void ecsact_mock_runtime_configure(
+	const ecsact_mock_runtime_options* options
+) {
+	configured_options() = options ? *options : default_options();
+}
+
+auto ecsact_create_registry( //
+	const char* registry_name
+) -> ecsact_registry_id {
+	if(!check_options(configured_options())) {
+		return ECSACT_INVALID_ID(registry);
+	}
+
+	auto id = ++last_registry_id;
+	registries.emplace(id, mock_world{configured_options()});
+	return static_cast<ecsact_registry_id>(id);
+}
+
+auto ecsact_destroy_registry(ecsact_registry_id registry_id) -> void {
+	registries.erase(static_cast<int32_t>(registry_id));
+}
+
+auto ecsact_execute_systems(
+	ecsact_registry_id                       registry_id,
+	int                                      execution_count,
+	const ecsact_execution_options*          execution_options_list,
+	const ecsact_execution_events_collector* events_collector
+) -> ecsact_execute_systems_error {
+	auto itr = registries.find(static_cast<int32_t>(registry_id));
+	if(itr == registries.end()) {
+		return ECSACT_EXEC_SYS_OK;
+	}
+
+	auto& world = itr->second;
+	for(auto i = 0; execution_count > i; ++i) {
+		if(execution_options_list) {
+			apply_execution_options(
+				world,
+				execution_options_list[i],
+				events_collector
+			);
+		}
+		tick_world(world, events_collector);
+	}
+
+	return ECSACT_EXEC_SYS_OK;
+}
+
+auto ecsact_async_start( //
+	const void* option_data,
+	int32_t     option_data_size
+) -> ecsact_async_session_id {
+	auto options = configured_options();
+	if(option_data && option_data_size == sizeof(ecsact_mock_runtime_options)) {
+		std::memcpy(&options, option_data, sizeof(ecsact_mock_runtime_options));
+	}
+	if(!check_options(options)) {
+		return ECSACT_INVALID_ID(async_session);
+	}
+
+	auto id = ++last_session_id;
+	sessions.emplace(id, mock_session{.world = mock_world{options}});
+	return static_cast<ecsact_async_session_id>(id);
+}
+
+auto ecsact_async_stop(ecsact_async_session_id session_id) -> void {
+	sessions.erase(static_cast<int32_t>(session_id));
+}
+
+auto ecsact_async_force_reset(ecsact_async_session_id session_id) -> void {
+	auto itr = sessions.find(static_cast<int32_t>(session_id));
+	if(itr != sessions.end()) {
+		auto options = itr->second.world.options;
+		itr->second = mock_session{.world = mock_world{options}};
+	}
+}
+
+auto ecsact_async_get_current_tick( //
+	ecsact_async_session_id session_id
+) -> int32_t {
+	auto itr = sessions.find(static_cast<int32_t>(session_id));
+	if(itr == sessions.end()) {
+		return 0;
+	}
+	return itr->second.world.tick;
+}
+
+auto ecsact_async_enqueue_execution_options(
+	ecsact_async_session_id        session_id,
+	const ecsact_execution_options options
+) -> ecsact_async_request_id {
+	auto itr = sessions.find(static_cast<int32_t>(session_id));
+	if(itr == sessions.end()) {
+		return ECSACT_INVALID_ID(async_request);
+	}
+
+	auto& session = itr->second;
+	auto  latency = session.world.options.request_latency_ticks;
+	if(session.world.options.request_latency_jitter > 0) {
+		auto jitter = std::uniform_int_distribution<int32_t>{
+			0,
+			session.world.options.request_latency_jitter,
+		};
+		latency += jitter(session.world.rng);
+	}
+
+	auto& request = session.requests.emplace_back(mock_request{
+		.id = static_cast<ecsact_async_request_id>(++last_request_id),
+		.done_tick = session.world.tick + std::max(latency, 0),
+	});
+	request.create_entities.assign(
+		options.create_entities,
+		options.create_entities + options.create_entities_length
+	);
+	request.destroy_entities.assign(
+		options.destroy_entities,
+		options.destroy_entities + options.destroy_entities_length
+	);
+
+	return request.id;
+}
+
+auto ecsact_async_flush_events(
+	ecsact_async_session_id                  session_id,
+	const ecsact_execution_events_collector* execution_events,
+	const ecsact_async_events_collector*     async_events
+) -> void {
+	auto itr = sessions.find(static_cast<int32_t>(session_id));
+	if(itr == sessions.end()) {
+		return;
+	}
+
+	auto& session = itr->second;
+	if(!session.started) {
+		session.started = true;
+		if(async_events && async_events->async_session_event_callback) {
+			async_events->async_session_event_callback(
+				session_id,
+				ECSACT_ASYNC_SESSION_START,
+				async_events->async_session_event_callback_user_data
+			);
+		}
+	}
+
+	tick_world(session.world, execution_events);
+
+	auto done_request_ids = std::vector<ecsact_async_request_id>{};
+	auto done_itr = std::stable_partition(
+		session.requests.begin(),
+		session.requests.end(),
+		[&](const mock_request& request) {
+			return request.done_tick > session.world.tick;
+		}
+	);
+	for(auto req_itr = done_itr; req_itr != session.requests.end(); ++req_itr) {
+		for(auto placeholder_id : req_itr->create_entities) {
+			emit_entity_created(session.world, placeholder_id, execution_events);
+		}
+		for(auto entity : req_itr->destroy_entities) {
+			emit_entity_destroyed(session.world, entity, execution_events);
+		}
+		done_request_ids.push_back(req_itr->id);
+	}
+	session.requests.erase(done_itr, session.requests.end());
+
+	if(!done_request_ids.empty() && async_events &&
+		 async_events->async_request_done_callback) {
+		async_events->async_request_done_callback(
+			session_id,
+			static_cast<int>(done_request_ids.size()),
+			done_request_ids.data(),
+			async_events->async_request_done_callback_user_data
+		);
+	}
+}
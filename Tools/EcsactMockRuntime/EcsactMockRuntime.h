@@ -0,0 +1,61 @@
+// Copyright (c) 2025 Seaube Software CORP. <https://seaube.com>
+//
+// This file is part of the Ecsact Unreal plugin.
+// Distributed under the MIT License. (See accompanying file LICENSE or view
+// online at <https://github.com/ecsact-dev/ecsact_unreal/blob/main/LICENSE>)
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Options for the mock Ecsact runtime. Pass as the option data to
+ * `ecsact_async_start` or set for all new registries/sessions with
+ * `ecsact_mock_runtime_configure`.
+ *
+ * Defaults may also be given through environment variables so CI can drive
+ * the mock without code changes:
+ *  ECSACT_MOCK_ENTITY_COUNT
+ *  ECSACT_MOCK_COMPONENT_ID
+ *  ECSACT_MOCK_COMPONENT_SIZE
+ *  ECSACT_MOCK_UPDATES_PER_TICK
+ *  ECSACT_MOCK_UPDATE_JITTER
+ *  ECSACT_MOCK_REQUEST_LATENCY_TICKS
+ *  ECSACT_MOCK_REQUEST_LATENCY_JITTER
+ *  ECSACT_MOCK_SEED
+ */
+struct ecsact_mock_runtime_options {
+	/** Entities created (with one synthetic component) on the first tick. */
+	int32_t entity_count;
+
+	/**
+	 * Component id used for the synthetic init/update events. Required. Must be
+	 * a component of the schema your generated code was built from since the
+	 * generated runner subsystems index their handlers by component id.
+	 */
+	int32_t component_id;
+
+	/**
+	 * Size in bytes of the synthetic component payload. Must be at least the
+	 * size of component_id's C++ struct.
+	 */
+	int32_t component_size;
+
+	/** Synthetic update events emitted every tick. */
+	int32_t updates_per_tick;
+
+	/** Random +/- amount applied to updates_per_tick every tick. */
+	int32_t update_jitter;
+
+	/** Ticks before an async request is reported as done. */
+	int32_t request_latency_ticks;
+
+	/** Random extra ticks (0..N) added to request_latency_ticks. */
+	int32_t request_latency_jitter;
+
+	/** Seed for all randomness so runs are deterministic. */
+	uint32_t seed;
+};
+
+using ecsact_mock_runtime_configure_fn =
+	void (*)(const ecsact_mock_runtime_options* options);
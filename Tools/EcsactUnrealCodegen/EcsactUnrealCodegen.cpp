@@ -1,4 +1,14 @@
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <sstream>
+#include <unordered_map>
 #include <ranges>
 #include <filesystem>
 #ifdef __cpp_lib_execution
@@ -181,6 +191,378 @@ auto trim(std::string_view str) -> std::string_view {
 	return trim_prefix(trim_suffix(str));
 }
 
+/**
+ * The .ecsact file index shared with the EcsactEditor module. See
+ * FEcsactFileIndex for the file layout. Times are unix milliseconds.
+ */
+struct ecsact_file_index {
+	std::map<std::string, std::int64_t> dirs;
+	std::map<std::string, std::int64_t> files;
+};
+
+constexpr auto ecsact_file_index_header = "ecsact-file-index 1";
+
+auto to_unix_ms(fs::file_time_type time) -> std::int64_t {
+	using namespace std::chrono;
+	auto sys_time = file_clock::to_sys(time);
+	return duration_cast<milliseconds>(sys_time.time_since_epoch()).count();
+}
+
+auto parent_of(const std::string& path) -> std::string {
+	auto index = path.find_last_of('/');
+	if(index == std::string::npos) {
+		return {};
+	}
+	return path.substr(0, index);
+}
+
+auto read_ecsact_file_index(const fs::path& index_path) -> ecsact_file_index {
+	auto index = ecsact_file_index{};
+	auto stream = std::ifstream{index_path};
+	auto line = std::string{};
+	auto read_line = [&]() -> bool {
+		if(!std::getline(stream, line)) {
+			return false;
+		}
+		if(line.ends_with("\r")) {
+			line.pop_back();
+		}
+		return true;
+	};
+
+	if(!read_line() || line != ecsact_file_index_header) {
+		return index;
+	}
+
+	while(read_line()) {
+		auto kind_end = line.find(' ');
+		auto mtime_end = line.find(' ', kind_end + 1);
+		if(kind_end == std::string::npos || mtime_end == std::string::npos) {
+			continue;
+		}
+
+		auto kind = line.substr(0, kind_end);
+		auto mtime = std::strtoll(line.c_str() + kind_end + 1, nullptr, 10);
+		auto path = line.substr(mtime_end + 1);
+		if(kind == "d") {
+			index.dirs[path] = mtime;
+		} else if(kind == "f") {
+			index.files[path] = mtime;
+		}
+	}
+
+	return index;
+}
+
+auto write_ecsact_file_index(
+	const fs::path&          index_path,
+	const ecsact_file_index& index
+) -> void {
+	auto ec = std::error_code{};
+	fs::create_directories(index_path.parent_path(), ec);
+
+	// Written to a temporary file first so the editor never reads a partially
+	// written index
+	auto temp_path = index_path;
+	temp_path += ".tmp";
+	{
+		auto stream = std::ofstream{temp_path, std::ios::trunc};
+		stream << ecsact_file_index_header << "\n";
+		for(auto&& [path, mtime] : index.dirs) {
+			stream << "d " << mtime << " " << path << "\n";
+		}
+		for(auto&& [path, mtime] : index.files) {
+			stream << "f " << mtime << " " << path << "\n";
+		}
+	}
+
+	fs::rename(temp_path, index_path, ec);
+}
+
+/**
+ * Lists the directories under @p source_dir whose modification time differs
+ * from @p prev and reuses the entries of every other directory.
+ */
+auto refresh_ecsact_file_index( //
+	const fs::path&          source_dir,
+	const ecsact_file_index& prev
+) -> ecsact_file_index {
+	auto prev_files = std::unordered_map<std::string, std::vector<std::string>>{};
+	auto prev_subdirs =
+		std::unordered_map<std::string, std::vector<std::string>>{};
+	for(auto&& [path, _] : prev.files) {
+		prev_files[parent_of(path)].push_back(path);
+	}
+	for(auto&& [path, _] : prev.dirs) {
+		prev_subdirs[parent_of(path)].push_back(path);
+	}
+
+	auto index = ecsact_file_index{};
+	auto pending_dirs = std::vector<std::string>{source_dir.generic_string()};
+	while(!pending_dirs.empty()) {
+		auto dir = std::move(pending_dirs.back());
+		pending_dirs.pop_back();
+
+		auto ec = std::error_code{};
+		auto dir_mtime = fs::last_write_time(dir, ec);
+		if(ec) {
+			continue;
+		}
+
+		auto dir_mtime_ms = to_unix_ms(dir_mtime);
+		index.dirs[dir] = dir_mtime_ms;
+
+		auto prev_dir = prev.dirs.find(dir);
+		if(prev_dir == prev.dirs.end() || prev_dir->second != dir_mtime_ms) {
+			for(auto entry : fs::directory_iterator(dir, ec)) {
+				auto entry_path = entry.path().generic_string();
+				if(entry.is_directory(ec)) {
+					pending_dirs.push_back(entry_path);
+				} else if(entry.path().extension() == ".ecsact") {
+					index.files[entry_path] = to_unix_ms(entry.last_write_time(ec));
+				}
+			}
+			continue;
+		}
+
+		for(auto&& file : prev_files[dir]) {
+			auto file_mtime = fs::last_write_time(file, ec);
+			if(!ec) {
+				index.files[file] = to_unix_ms(file_mtime);
+			}
+		}
+
+		for(auto&& subdir : prev_subdirs[dir]) {
+			pending_dirs.push_back(subdir);
+		}
+	}
+
+	return index;
+}
+
+struct ecsact_package_info {
+	fs::path                 path;
+	std::string              name;
+	std::vector<std::string> imports;
+	std::string              source;
+};
+
+/**
+ * 64-bit FNV-1a. Only used to detect changed codegen inputs.
+ */
+auto fnv1a(std::string_view data, std::uint64_t hash = 14695981039346656037ull)
+	-> std::uint64_t {
+	for(auto c : data) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+/**
+ * Reads the package and import statements at the top of an .ecsact file.
+ * Everything from the first declaration body is ignored.
+ */
+auto read_ecsact_package(const fs::path& path) -> ecsact_package_info {
+	auto info = ecsact_package_info{.path = path};
+	auto stream = std::ifstream{path, std::ios::binary};
+	info.source = std::string{
+		std::istreambuf_iterator<char>{stream},
+		std::istreambuf_iterator<char>{},
+	};
+
+	auto header = std::string{};
+	auto& src = info.source;
+	for(auto i = size_t{0}; src.size() > i; ++i) {
+		if(src.compare(i, 2, "//") == 0) {
+			i = src.find('\n', i);
+			if(i == std::string::npos) {
+				break;
+			}
+			header += ' ';
+			continue;
+		}
+		if(src.compare(i, 2, "/*") == 0) {
+			i = src.find("*/", i + 2);
+			if(i == std::string::npos) {
+				break;
+			}
+			i += 1;
+			header += ' ';
+			continue;
+		}
+		if(src[i] == '{') {
+			break;
+		}
+		header += src[i];
+	}
+
+	auto statements = std::istringstream{header};
+	auto statement = std::string{};
+	while(std::getline(statements, statement, ';')) {
+		auto tokens = std::vector<std::string>{};
+		auto token_stream = std::istringstream{statement};
+		for(auto token = std::string{}; token_stream >> token;) {
+			tokens.push_back(token);
+		}
+
+		if(tokens.size() == 3 && tokens[0] == "main" && tokens[1] == "package") {
+			info.name = tokens[2];
+		} else if(tokens.size() == 2 && tokens[0] == "package") {
+			info.name = tokens[1];
+		} else if(tokens.size() == 2 && tokens[0] == "import") {
+			info.imports.push_back(tokens[1]);
+		} else if(!tokens.empty()) {
+			break;
+		}
+	}
+
+	return info;
+}
+
+/**
+ * Hashes each package's source, the hashes of everything it imports and
+ * @p inputs_hash. Keyed by the package file path.
+ */
+auto hash_ecsact_packages(
+	const std::vector<ecsact_package_info>& packages,
+	std::uint64_t                           inputs_hash
+) -> std::map<std::string, std::uint64_t> {
+	auto by_name = std::unordered_map<std::string, const ecsact_package_info*>{};
+	for(auto& pkg : packages) {
+		by_name[pkg.name] = &pkg;
+	}
+
+	auto hashes_by_name = std::unordered_map<std::string, std::uint64_t>{};
+	auto hash_package = [&](auto& self, const ecsact_package_info& pkg) {
+		if(auto itr = hashes_by_name.find(pkg.name); itr != hashes_by_name.end()) {
+			return itr->second;
+		}
+
+		// Seeded so an import cycle terminates. ecsact codegen reports it.
+		auto hash = fnv1a(pkg.source, inputs_hash);
+		hashes_by_name[pkg.name] = hash;
+
+		auto imports = pkg.imports;
+		std::ranges::sort(imports);
+		for(auto& import : imports) {
+			hash = fnv1a(import, hash);
+			if(auto itr = by_name.find(import); itr != by_name.end()) {
+				auto import_hash = self(self, *itr->second);
+				hash = fnv1a(
+					{reinterpret_cast<const char*>(&import_hash), sizeof(import_hash)},
+					hash
+				);
+			}
+		}
+
+		hashes_by_name[pkg.name] = hash;
+		return hash;
+	};
+
+	auto hashes = std::map<std::string, std::uint64_t>{};
+	for(auto& pkg : packages) {
+		hashes[pkg.path.generic_string()] = hash_package(hash_package, pkg);
+	}
+	return hashes;
+}
+
+auto read_codegen_hashes( //
+	const fs::path& path
+) -> std::map<std::string, std::uint64_t> {
+	auto hashes = std::map<std::string, std::uint64_t>{};
+	auto stream = std::ifstream{path};
+	auto line = std::string{};
+	while(std::getline(stream, line)) {
+		if(line.ends_with("\r")) {
+			line.pop_back();
+		}
+		auto space = line.find(' ');
+		if(space == std::string::npos) {
+			continue;
+		}
+		hashes[line.substr(space + 1)] =
+			std::strtoull(line.c_str(), nullptr, 16);
+	}
+	return hashes;
+}
+
+auto write_codegen_hashes(
+	const fs::path&                             path,
+	const std::map<std::string, std::uint64_t>& hashes
+) -> void {
+	auto ec = std::error_code{};
+	fs::create_directories(path.parent_path(), ec);
+	auto stream = std::ofstream{path, std::ios::trunc};
+	stream << std::hex;
+	for(auto&& [file, hash] : hashes) {
+		stream << hash << " " << file << "\n";
+	}
+}
+
+/**
+ * Copies @p src over @p dst unless @p dst already has the same contents so
+ * unchanged generated files keep their timestamps.
+ */
+auto write_if_different(const fs::path& src, const fs::path& dst) -> bool {
+	auto read_all = [](const fs::path& p) -> std::optional<std::string> {
+		auto stream = std::ifstream{p, std::ios::binary};
+		if(!stream) {
+			return std::nullopt;
+		}
+		return std::string{
+			std::istreambuf_iterator<char>{stream},
+			std::istreambuf_iterator<char>{},
+		};
+	};
+
+	auto src_contents = read_all(src);
+	if(!src_contents) {
+		return false;
+	}
+
+	if(read_all(dst) == src_contents) {
+		return false;
+	}
+
+	auto stream = std::ofstream{dst, std::ios::binary | std::ios::trunc};
+	stream << *src_contents;
+	return true;
+}
+
+/**
+ * Removes generated source shards next to @p ecsact_file that this run did
+ * not produce. A left over shard would define its components a second time.
+ */
+auto remove_stale_shards(
+	const fs::path&              ecsact_file,
+	const std::set<std::string>& output_filenames
+) -> void {
+	auto stem = ecsact_file.stem().string();
+	auto shard_prefixes = std::array{
+		stem + "__ecsact__ue_",
+		stem + "__ecsact__mass__ue_",
+	};
+
+	auto ec = std::error_code{};
+	for(auto entry : fs::directory_iterator{ecsact_file.parent_path(), ec}) {
+		auto filename = entry.path().filename().string();
+		if(entry.path().extension() != ".cpp" ||
+			 output_filenames.contains(filename)) {
+			continue;
+		}
+
+		for(auto& prefix : shard_prefixes) {
+			if(filename.starts_with(prefix)) {
+				std::cout //
+					<< "INFO: removing stale " << entry.path().generic_string() << "\n";
+				fs::remove(entry.path(), ec);
+				break;
+			}
+		}
+	}
+}
+
 auto main(int argc, char* argv[]) -> int {
 	auto desc = po::options_description{};
 	auto pos_desc = po::positional_options_description{};
@@ -190,6 +572,7 @@ auto main(int argc, char* argv[]) -> int {
 		("help", "show this help message")
 		("format", "run clang-format on generated c/c++ files")
 		("engine-dir", po::value<std::string>(), "the unreal engine directory this project uses")
+		("components-per-source", po::value<int>()->default_value(0), "max components per generated .cpp file (0 for no limit)")
 		("project-path", po::value<std::string>(), "path to unreal project file or directory");
 	// clang-format on
 
@@ -353,17 +736,125 @@ auto main(int argc, char* argv[]) -> int {
 		return 0;
 	}
 
-	auto ecsact_files = std::vector<fs::path>{};
-	for(auto entry : fs::recursive_directory_iterator(source_dir)) {
-		if(entry.path().extension() != ".ecsact") {
+	auto ecsact_file_index_path =
+		project_dir / "Intermediate" / "Ecsact" / "EcsactFileIndex.txt";
+	auto ecsact_file_index = refresh_ecsact_file_index(
+		source_dir,
+		read_ecsact_file_index(ecsact_file_index_path)
+	);
+	write_ecsact_file_index(ecsact_file_index_path, ecsact_file_index);
+
+	auto packages = std::vector<ecsact_package_info>{};
+	for(auto&& [path, _] : ecsact_file_index.files) {
+		auto& pkg = packages.emplace_back(read_ecsact_package(path));
+		if(pkg.name.empty()) {
+			// Left for ecsact codegen to report
+			pkg.name = path;
+		}
+	}
+
+	// Anything that changes generated code for every package
+	auto plugin_ec = std::error_code{};
+	auto inputs_hash = fnv1a(*version);
+	inputs_hash = fnv1a(vm.count("format") ? "format" : "", inputs_hash);
+	inputs_hash = fnv1a(
+		std::to_string(vm.at("components-per-source").as<int>()),
+		inputs_hash
+	);
+	inputs_hash = fnv1a(
+		std::to_string(fs::file_size(ecsact_unreal_codegen_plugin, plugin_ec)),
+		inputs_hash
+	);
+	inputs_hash = fnv1a(
+		std::to_string(to_unix_ms( //
+			fs::last_write_time(ecsact_unreal_codegen_plugin, plugin_ec)
+		)),
+		inputs_hash
+	);
+
+	auto codegen_hashes_path =
+		project_dir / "Intermediate" / "Ecsact" / "CodegenHashes.txt";
+	auto prev_codegen_hashes = read_codegen_hashes(codegen_hashes_path);
+	auto codegen_hashes = hash_ecsact_packages(packages, inputs_hash);
+
+	auto changed_packages = std::set<std::string>{};
+	for(auto& pkg : packages) {
+		auto path = pkg.path.generic_string();
+		auto prev_hash = prev_codegen_hashes.find(path);
+		auto generated_header = pkg.path.parent_path() /
+			(pkg.path.stem().string() + "__ecsact__ue.h");
+		if(prev_hash == prev_codegen_hashes.end() ||
+			 prev_hash->second != codegen_hashes.at(path) ||
+			 !fs::exists(generated_header)) {
+			changed_packages.insert(pkg.name);
+		}
+	}
+
+	if(changed_packages.empty()) {
+		std::cout << "INFO: generated code is up to date\n";
+		std::cout << "SUCCESS: ecsact codegen finished\n";
+		return 0;
+	}
+
+	std::cout //
+		<< "INFO: generating code for " << changed_packages.size() << " of "
+		<< packages.size() << " packages\n";
+
+	// Changed packages can only be generated together with their imports
+	auto packages_by_name =
+		std::unordered_map<std::string, const ecsact_package_info*>{};
+	for(auto& pkg : packages) {
+		packages_by_name[pkg.name] = &pkg;
+	}
+
+	auto codegen_packages = std::set<std::string>{};
+	auto pending_packages = std::vector<std::string>{
+		changed_packages.begin(),
+		changed_packages.end(),
+	};
+	while(!pending_packages.empty()) {
+		auto name = std::move(pending_packages.back());
+		pending_packages.pop_back();
+		if(!codegen_packages.insert(name).second) {
 			continue;
 		}
+		if(auto itr = packages_by_name.find(name); itr != packages_by_name.end()) {
+			for(auto& import : itr->second->imports) {
+				pending_packages.push_back(import);
+			}
+		}
+	}
 
-		ecsact_files.push_back(entry.path());
+	auto ecsact_files = std::vector<fs::path>{};
+	auto ecsact_file_stems = std::set<std::string>{};
+	auto staging_possible = true;
+	for(auto& name : codegen_packages) {
+		if(auto itr = packages_by_name.find(name); itr != packages_by_name.end()) {
+			ecsact_files.push_back(itr->second->path);
+			auto stem = itr->second->path.stem().string();
+			staging_possible &= ecsact_file_stems.insert(stem).second;
+		}
+	}
+
+	// Generated files are written to a staging directory first and only copied
+	// next to their .ecsact file if they differ. The staging directory is
+	// flat so packages with the same file name are generated in place.
+	auto codegen_staging_dir =
+		project_dir / "Intermediate" / "Ecsact" / "Codegen";
+	if(staging_possible) {
+		auto ec = std::error_code{};
+		fs::remove_all(codegen_staging_dir, ec);
+		fs::create_directories(codegen_staging_dir, ec);
 	}
 
 	auto ecsact_codegen_args = std::vector<std::string>{"codegen"};
 
+	if(staging_possible) {
+		ecsact_codegen_args.emplace_back( //
+			"--outdir=" + codegen_staging_dir.generic_string()
+		);
+	}
+
 	ecsact_codegen_args.emplace_back("--plugin");
 	ecsact_codegen_args.emplace_back("cpp_header");
 
@@ -376,9 +867,15 @@ auto main(int argc, char* argv[]) -> int {
 		ecsact_codegen_args.push_back(ecsact_file.generic_string());
 	}
 
+	// Read by the codegen plugin, see components_per_source()
+	auto codegen_env = bp::environment{boost::this_process::environment()};
+	codegen_env["ECSACT_UNREAL_CODEGEN_COMPONENTS_PER_SOURCE"] =
+		std::to_string(vm.at("components-per-source").as<int>());
+
 	auto codegen_proc = bp::child{
 		bp::exe(ecsact_cli->string()),
 		bp::args(ecsact_codegen_args),
+		codegen_env,
 	};
 
 	codegen_proc.wait();
@@ -389,6 +886,26 @@ auto main(int argc, char* argv[]) -> int {
 		return exit_code;
 	}
 
+	// With staging the outputs are known from this run so ecsact codegen
+	// doesn't need to parse every package again with --print-output-files
+	auto output_files = std::vector<fs::path>{};
+	if(staging_possible) {
+		auto ec = std::error_code{};
+		for(auto entry : fs::directory_iterator{codegen_staging_dir, ec}) {
+			if(entry.is_regular_file(ec)) {
+				output_files.push_back(entry.path());
+			}
+		}
+	} else {
+		ecsact_codegen_args.emplace_back("--print-output-files");
+		auto output_file_lines = proc_stdout_list(
+			bp::exe(ecsact_cli->string()),
+			bp::args(ecsact_codegen_args),
+			codegen_env
+		);
+		output_files.assign(output_file_lines.begin(), output_file_lines.end());
+	}
+
 	if(vm.count("format")) {
 		auto clang_format = bp::search_path("clang-format");
 
@@ -398,14 +915,8 @@ auto main(int argc, char* argv[]) -> int {
 			return 1;
 		}
 
-		ecsact_codegen_args.emplace_back("--print-output-files");
-		auto output_files = proc_stdout_list( //
-			bp::exe(ecsact_cli->string()),
-			bp::args(ecsact_codegen_args)
-		);
-
 		auto formattable_output_files = std::vector<fs::path>{};
-		for(fs::path output_path : output_files) {
+		for(auto& output_path : output_files) {
 			if(is_clang_formattable(output_path)) {
 				formattable_output_files.emplace_back(output_path);
 			}
@@ -439,6 +950,54 @@ auto main(int argc, char* argv[]) -> int {
 		}
 	}
 
+	if(staging_possible) {
+		auto changed_stems = std::vector<std::pair<std::string, fs::path>>{};
+		for(auto& name : changed_packages) {
+			auto& pkg = *packages_by_name.at(name);
+			changed_stems.emplace_back(pkg.path.stem().string(), pkg.path);
+		}
+
+		auto written_count = 0;
+		for(auto& output_path : output_files) {
+			auto filename = output_path.filename().string();
+
+			// Outputs are named after their package file. The longest matching
+			// stem wins so 'foo.bar' outputs aren't treated as 'foo' outputs.
+			auto owner = std::optional<fs::path>{};
+			auto owner_stem_length = size_t{0};
+			for(auto& [stem, path] : changed_stems) {
+				auto matches = filename.starts_with(stem + ".") ||
+					filename.starts_with(stem + "__");
+				if(matches && stem.size() > owner_stem_length) {
+					owner = path;
+					owner_stem_length = stem.size();
+				}
+			}
+
+			// Outputs of imported packages that didn't change
+			if(!owner) {
+				continue;
+			}
+
+			if(write_if_different(output_path, owner->parent_path() / filename)) {
+				written_count += 1;
+			}
+		}
+
+		std::cout //
+			<< "INFO: " << written_count << " generated files changed\n";
+	}
+
+	auto output_filenames = std::set<std::string>{};
+	for(auto& output_path : output_files) {
+		output_filenames.insert(output_path.filename().string());
+	}
+	for(auto& name : changed_packages) {
+		remove_stale_shards(packages_by_name.at(name)->path, output_filenames);
+	}
+
+	write_codegen_hashes(codegen_hashes_path, codegen_hashes);
+
 	std::cout << "SUCCESS: ecsact codegen finished\n";
 
 	return 0;